@@ -5,13 +5,127 @@
 #include "core/chrono/stopwatch.h"
 #include "core/util/random.h"
 
+#ifdef __linux__
+#include <linux/perf_event.h>
+#include <sys/ioctl.h>
+#include <sys/syscall.h>
+#include <unistd.h>
+#endif
+
+// Hardware counters sampled around each measured scenario. Each
+// counter is opened independently so that a counter the kernel or
+// hardware does not provide (e.g. in a VM or with a restrictive
+// perf_event_paranoid) is reported as n/a rather than disabling the
+// others. On non-Linux platforms every counter is unavailable.
+class PerfCounters {
+public:
+    struct Counter {
+	const char *name;
+	uint32_t type;
+	uint64_t config;
+	int fd{-1};
+	uint64_t value{};
+    };
+
+    PerfCounters() {
+#ifdef __linux__
+	for (auto& c : counters_)
+	    c.fd = open_counter(c.type, c.config);
+#endif
+    }
+
+    ~PerfCounters() {
+#ifdef __linux__
+	for (auto& c : counters_)
+	    if (c.fd >= 0)
+		close(c.fd);
+#endif
+    }
+
+    PerfCounters(const PerfCounters&) = delete;
+    PerfCounters& operator=(const PerfCounters&) = delete;
+
+    bool any_available() const {
+	return std::any_of(std::begin(counters_), std::end(counters_),
+			   [](const auto& c) { return c.fd >= 0; });
+    }
+
+    void start() {
+#ifdef __linux__
+	for (auto& c : counters_) {
+	    if (c.fd < 0) continue;
+	    ioctl(c.fd, PERF_EVENT_IOC_RESET, 0);
+	    ioctl(c.fd, PERF_EVENT_IOC_ENABLE, 0);
+	}
+#endif
+    }
+
+    void stop() {
+#ifdef __linux__
+	for (auto& c : counters_) {
+	    if (c.fd < 0) continue;
+	    ioctl(c.fd, PERF_EVENT_IOC_DISABLE, 0);
+	    if (read(c.fd, &c.value, sizeof(c.value)) != sizeof(c.value))
+		c.value = 0;
+	}
+#endif
+    }
+
+    std::string report() const {
+	std::string str;
+	for (const auto& c : counters_) {
+	    if (c.fd >= 0) str += fmt::format("  {}: {:>12d}", c.name, c.value);
+	    else str += fmt::format("  {}: {:>12s}", c.name, "n/a");
+	}
+	return str;
+    }
+
+private:
+#ifdef __linux__
+    static int open_counter(uint32_t type, uint64_t config) {
+	perf_event_attr attr{};
+	attr.size = sizeof(attr);
+	attr.type = type;
+	attr.config = config;
+	attr.disabled = 1;
+	attr.exclude_kernel = 1;
+	attr.exclude_hv = 1;
+	return syscall(SYS_perf_event_open, &attr, 0, -1, -1, 0);
+    }
+
+    static constexpr uint64_t cache_config(uint64_t cache, uint64_t op, uint64_t result) {
+	return cache bitor (op << 8) bitor (result << 16);
+    }
+
+    Counter counters_[4] = {
+	{ "instructions", PERF_TYPE_HARDWARE, PERF_COUNT_HW_INSTRUCTIONS },
+	{ "branch-misses", PERF_TYPE_HARDWARE, PERF_COUNT_HW_BRANCH_MISSES },
+	{ "llc-misses", PERF_TYPE_HW_CACHE, cache_config(PERF_COUNT_HW_CACHE_LL,
+							 PERF_COUNT_HW_CACHE_OP_READ,
+							 PERF_COUNT_HW_CACHE_RESULT_MISS) },
+	{ "dtlb-misses", PERF_TYPE_HW_CACHE, cache_config(PERF_COUNT_HW_CACHE_DTLB,
+							  PERF_COUNT_HW_CACHE_OP_READ,
+							  PERF_COUNT_HW_CACHE_RESULT_MISS) }
+    };
+#else
+    Counter counters_[4] = {
+	{ "instructions", 0, 0 },
+	{ "branch-misses", 0, 0 },
+	{ "llc-misses", 0, 0 },
+	{ "dtlb-misses", 0, 0 }
+    };
+#endif
+};
+
 template<class Work>
-void measure(std::ostream& os, std::string_view desc, Work&& work) {
+void measure(std::ostream& os, PerfCounters& counters, std::string_view desc, Work&& work) {
     chron::StopWatch timer;
+    counters.start();
     timer.mark();
     work();
     auto millis = timer.elapsed_duration<std::chrono::milliseconds>().count();
-    os << fmt::format("{:>16s}: {:5d} ms", desc, millis) << endl;
+    counters.stop();
+    os << fmt::format("{:>16s}: {:5d} ms", desc, millis) << counters.report() << endl;
 }
 
 int tool_main(int argc, const char *argv[]) {
@@ -22,7 +136,11 @@ int tool_main(int argc, const char *argv[]) {
 	 );
     opts.parse(argc, argv);
     auto n = opts.get<'n'>();
-    // auto verbose = opts.get<'v'>();
+    auto verbose = opts.get<'v'>();
+
+    PerfCounters counters;
+    if (verbose and not counters.any_available())
+	cout << "hardware counters unavailable (check perf_event_paranoid)" << endl;
 
     using Set = std::set<uint64_t>;
     using Elements = std::vector<Set::value_type>;
@@ -39,7 +157,7 @@ int tool_main(int argc, const char *argv[]) {
     Iterators iterators(n);
     for (auto i = 0; i < n; ++i)
 	iterators[i] = data.find(i);
-    measure(cout, "iterator-ordered", [&]() {
+    measure(cout, counters, "iterator-ordered", [&]() {
 	for (auto iter : iterators) {
 	    data.erase(iter);
 	}
@@ -49,7 +167,7 @@ int tool_main(int argc, const char *argv[]) {
     for (auto i = 0; i < n; ++i)
 	iterators[i] = data.find(i);
     std::reverse(iterators.begin(), iterators.end());
-    measure(cout, "iterator-reverse", [&]() {
+    measure(cout, counters, "iterator-reverse", [&]() {
 	for (auto iter : iterators)
 	    data.erase(iter);
     });
@@ -58,27 +176,27 @@ int tool_main(int argc, const char *argv[]) {
     for (auto i = 0; i < n; ++i)
 	iterators[i] = data.find(i);
     std::shuffle(iterators.begin(), iterators.end(), core::rng());
-    measure(cout, "iterator-random", [&]() {
+    measure(cout, counters, "iterator-random", [&]() {
 	for (auto iter : iterators)
 	    data.erase(iter);
     });
     
     data = src_data;
-    measure(cout, "value-ordered", [&]() { ;
+    measure(cout, counters, "value-ordered", [&]() { ;
 	    for (auto value : elements)
 		data.erase(value);
     });
 
     data = src_data;
     std::reverse(elements.begin(), elements.end());
-    measure(cout, "value-reverse", [&]() { ;
+    measure(cout, counters, "value-reverse", [&]() { ;
 	    for (auto value : elements)
 		data.erase(value);
     });
     
     data = src_data;
     std::shuffle(elements.begin(), elements.end(), core::rng());
-    measure(cout, "value-random", [&]() { ;
+    measure(cout, counters, "value-random", [&]() { ;
 	    for (auto value : elements)
 		data.erase(value);
     });
@@ -0,0 +1,2114 @@
+// Copyright (C) 2022, 2023 by Mark Melton
+//
+// Generated by gen_aggr_bindings.py -- do not edit.
+//
+
+#pragma once
+
+#define AGGR_FIELD_LIMIT 64
+
+template<class T>
+struct aggr_field_type_impl<T, 0> {
+    static auto ignore() { return aggr_field_list<>{};  }
+    using type = decltype(ignore());
+
+    template<class U>
+    static auto tie(U&) { return std::tuple<>{}; }
+};
+
+template<class T>
+struct aggr_field_type_impl<T, 1> {
+    static auto ignore() {
+	T *x = nullptr;
+	auto [m0] = *x;
+	return aggr_field_list<decltype(m0)>{};
+    }
+    using type = decltype(ignore());
+
+    template<class U>
+    static auto tie(U& x) {
+	auto& [m0] = x;
+	return std::tie(m0);
+    }
+};
+
+template<class T>
+struct aggr_field_type_impl<T, 2> {
+    static auto ignore() {
+	T *x = nullptr;
+	auto [m0, m1] = *x;
+	return aggr_field_list<decltype(m0), decltype(m1)>{};
+    }
+    using type = decltype(ignore());
+
+    template<class U>
+    static auto tie(U& x) {
+	auto& [m0, m1] = x;
+	return std::tie(m0, m1);
+    }
+};
+
+template<class T>
+struct aggr_field_type_impl<T, 3> {
+    static auto ignore() {
+	T *x = nullptr;
+	auto [m0, m1, m2] = *x;
+	return aggr_field_list<decltype(m0), decltype(m1), decltype(m2)>{};
+    }
+    using type = decltype(ignore());
+
+    template<class U>
+    static auto tie(U& x) {
+	auto& [m0, m1, m2] = x;
+	return std::tie(m0, m1, m2);
+    }
+};
+
+template<class T>
+struct aggr_field_type_impl<T, 4> {
+    static auto ignore() {
+	T *x = nullptr;
+	auto [m0, m1, m2, m3] = *x;
+	return aggr_field_list<decltype(m0), decltype(m1), decltype(m2),
+			       decltype(m3)>{};
+    }
+    using type = decltype(ignore());
+
+    template<class U>
+    static auto tie(U& x) {
+	auto& [m0, m1, m2, m3] = x;
+	return std::tie(m0, m1, m2, m3);
+    }
+};
+
+template<class T>
+struct aggr_field_type_impl<T, 5> {
+    static auto ignore() {
+	T *x = nullptr;
+	auto [m0, m1, m2, m3, m4] = *x;
+	return aggr_field_list<decltype(m0), decltype(m1), decltype(m2),
+			       decltype(m3), decltype(m4)>{};
+    }
+    using type = decltype(ignore());
+
+    template<class U>
+    static auto tie(U& x) {
+	auto& [m0, m1, m2, m3, m4] = x;
+	return std::tie(m0, m1, m2, m3, m4);
+    }
+};
+
+template<class T>
+struct aggr_field_type_impl<T, 6> {
+    static auto ignore() {
+	T *x = nullptr;
+	auto [m0, m1, m2, m3, m4, m5] = *x;
+	return aggr_field_list<decltype(m0), decltype(m1), decltype(m2),
+			       decltype(m3), decltype(m4), decltype(m5)>{};
+    }
+    using type = decltype(ignore());
+
+    template<class U>
+    static auto tie(U& x) {
+	auto& [m0, m1, m2, m3, m4, m5] = x;
+	return std::tie(m0, m1, m2, m3, m4, m5);
+    }
+};
+
+template<class T>
+struct aggr_field_type_impl<T, 7> {
+    static auto ignore() {
+	T *x = nullptr;
+	auto [m0, m1, m2, m3, m4, m5, m6] = *x;
+	return aggr_field_list<decltype(m0), decltype(m1), decltype(m2),
+			       decltype(m3), decltype(m4), decltype(m5),
+			       decltype(m6)>{};
+    }
+    using type = decltype(ignore());
+
+    template<class U>
+    static auto tie(U& x) {
+	auto& [m0, m1, m2, m3, m4, m5, m6] = x;
+	return std::tie(m0, m1, m2, m3, m4, m5, m6);
+    }
+};
+
+template<class T>
+struct aggr_field_type_impl<T, 8> {
+    static auto ignore() {
+	T *x = nullptr;
+	auto [m0, m1, m2, m3, m4, m5, m6, m7] = *x;
+	return aggr_field_list<decltype(m0), decltype(m1), decltype(m2),
+			       decltype(m3), decltype(m4), decltype(m5),
+			       decltype(m6), decltype(m7)>{};
+    }
+    using type = decltype(ignore());
+
+    template<class U>
+    static auto tie(U& x) {
+	auto& [m0, m1, m2, m3, m4, m5, m6, m7] = x;
+	return std::tie(m0, m1, m2, m3, m4, m5, m6, m7);
+    }
+};
+
+template<class T>
+struct aggr_field_type_impl<T, 9> {
+    static auto ignore() {
+	T *x = nullptr;
+	auto [m0, m1, m2, m3, m4, m5, m6, m7, m8] = *x;
+	return aggr_field_list<decltype(m0), decltype(m1), decltype(m2),
+			       decltype(m3), decltype(m4), decltype(m5),
+			       decltype(m6), decltype(m7), decltype(m8)>{};
+    }
+    using type = decltype(ignore());
+
+    template<class U>
+    static auto tie(U& x) {
+	auto& [m0, m1, m2, m3, m4, m5, m6, m7, m8] = x;
+	return std::tie(m0, m1, m2, m3, m4, m5, m6, m7, m8);
+    }
+};
+
+template<class T>
+struct aggr_field_type_impl<T, 10> {
+    static auto ignore() {
+	T *x = nullptr;
+	auto [m0, m1, m2, m3, m4, m5, m6, m7, m8, m9] = *x;
+	return aggr_field_list<decltype(m0), decltype(m1), decltype(m2),
+			       decltype(m3), decltype(m4), decltype(m5),
+			       decltype(m6), decltype(m7), decltype(m8),
+			       decltype(m9)>{};
+    }
+    using type = decltype(ignore());
+
+    template<class U>
+    static auto tie(U& x) {
+	auto& [m0, m1, m2, m3, m4, m5, m6, m7, m8, m9] = x;
+	return std::tie(m0, m1, m2, m3, m4, m5, m6, m7, m8, m9);
+    }
+};
+
+template<class T>
+struct aggr_field_type_impl<T, 11> {
+    static auto ignore() {
+	T *x = nullptr;
+	auto [m0, m1, m2, m3, m4, m5, m6, m7, m8, m9, m10] = *x;
+	return aggr_field_list<decltype(m0), decltype(m1), decltype(m2),
+			       decltype(m3), decltype(m4), decltype(m5),
+			       decltype(m6), decltype(m7), decltype(m8),
+			       decltype(m9), decltype(m10)>{};
+    }
+    using type = decltype(ignore());
+
+    template<class U>
+    static auto tie(U& x) {
+	auto& [m0, m1, m2, m3, m4, m5, m6, m7, m8, m9, m10] = x;
+	return std::tie(m0, m1, m2, m3, m4, m5, m6, m7, m8, m9, m10);
+    }
+};
+
+template<class T>
+struct aggr_field_type_impl<T, 12> {
+    static auto ignore() {
+	T *x = nullptr;
+	auto [m0, m1, m2, m3, m4, m5, m6, m7, m8, m9, m10, m11] = *x;
+	return aggr_field_list<decltype(m0), decltype(m1), decltype(m2),
+			       decltype(m3), decltype(m4), decltype(m5),
+			       decltype(m6), decltype(m7), decltype(m8),
+			       decltype(m9), decltype(m10), decltype(m11)>{};
+    }
+    using type = decltype(ignore());
+
+    template<class U>
+    static auto tie(U& x) {
+	auto& [m0, m1, m2, m3, m4, m5, m6, m7, m8, m9, m10, m11] = x;
+	return std::tie(m0, m1, m2, m3, m4, m5, m6, m7, m8, m9, m10, m11);
+    }
+};
+
+template<class T>
+struct aggr_field_type_impl<T, 13> {
+    static auto ignore() {
+	T *x = nullptr;
+	auto [m0, m1, m2, m3, m4, m5, m6, m7, m8, m9, m10, m11, m12] = *x;
+	return aggr_field_list<decltype(m0), decltype(m1), decltype(m2),
+			       decltype(m3), decltype(m4), decltype(m5),
+			       decltype(m6), decltype(m7), decltype(m8),
+			       decltype(m9), decltype(m10), decltype(m11),
+			       decltype(m12)>{};
+    }
+    using type = decltype(ignore());
+
+    template<class U>
+    static auto tie(U& x) {
+	auto& [m0, m1, m2, m3, m4, m5, m6, m7, m8, m9, m10, m11, m12] = x;
+	return std::tie(m0, m1, m2, m3, m4, m5, m6, m7, m8, m9, m10, m11,
+			m12);
+    }
+};
+
+template<class T>
+struct aggr_field_type_impl<T, 14> {
+    static auto ignore() {
+	T *x = nullptr;
+	auto [m0, m1, m2, m3, m4, m5, m6, m7, m8, m9, m10, m11, m12, m13] = *x;
+	return aggr_field_list<decltype(m0), decltype(m1), decltype(m2),
+			       decltype(m3), decltype(m4), decltype(m5),
+			       decltype(m6), decltype(m7), decltype(m8),
+			       decltype(m9), decltype(m10), decltype(m11),
+			       decltype(m12), decltype(m13)>{};
+    }
+    using type = decltype(ignore());
+
+    template<class U>
+    static auto tie(U& x) {
+	auto& [m0, m1, m2, m3, m4, m5, m6, m7, m8, m9, m10, m11, m12, m13] = x;
+	return std::tie(m0, m1, m2, m3, m4, m5, m6, m7, m8, m9, m10, m11,
+			m12, m13);
+    }
+};
+
+template<class T>
+struct aggr_field_type_impl<T, 15> {
+    static auto ignore() {
+	T *x = nullptr;
+	auto [m0, m1, m2, m3, m4, m5, m6, m7, m8, m9, m10, m11, m12, m13,
+	      m14] = *x;
+	return aggr_field_list<decltype(m0), decltype(m1), decltype(m2),
+			       decltype(m3), decltype(m4), decltype(m5),
+			       decltype(m6), decltype(m7), decltype(m8),
+			       decltype(m9), decltype(m10), decltype(m11),
+			       decltype(m12), decltype(m13), decltype(m14)>{};
+    }
+    using type = decltype(ignore());
+
+    template<class U>
+    static auto tie(U& x) {
+	auto& [m0, m1, m2, m3, m4, m5, m6, m7, m8, m9, m10, m11, m12, m13,
+	       m14] = x;
+	return std::tie(m0, m1, m2, m3, m4, m5, m6, m7, m8, m9, m10, m11,
+			m12, m13, m14);
+    }
+};
+
+template<class T>
+struct aggr_field_type_impl<T, 16> {
+    static auto ignore() {
+	T *x = nullptr;
+	auto [m0, m1, m2, m3, m4, m5, m6, m7, m8, m9, m10, m11, m12, m13,
+	      m14, m15] = *x;
+	return aggr_field_list<decltype(m0), decltype(m1), decltype(m2),
+			       decltype(m3), decltype(m4), decltype(m5),
+			       decltype(m6), decltype(m7), decltype(m8),
+			       decltype(m9), decltype(m10), decltype(m11),
+			       decltype(m12), decltype(m13), decltype(m14),
+			       decltype(m15)>{};
+    }
+    using type = decltype(ignore());
+
+    template<class U>
+    static auto tie(U& x) {
+	auto& [m0, m1, m2, m3, m4, m5, m6, m7, m8, m9, m10, m11, m12, m13,
+	       m14, m15] = x;
+	return std::tie(m0, m1, m2, m3, m4, m5, m6, m7, m8, m9, m10, m11,
+			m12, m13, m14, m15);
+    }
+};
+
+template<class T>
+struct aggr_field_type_impl<T, 17> {
+    static auto ignore() {
+	T *x = nullptr;
+	auto [m0, m1, m2, m3, m4, m5, m6, m7, m8, m9, m10, m11, m12, m13,
+	      m14, m15, m16] = *x;
+	return aggr_field_list<decltype(m0), decltype(m1), decltype(m2),
+			       decltype(m3), decltype(m4), decltype(m5),
+			       decltype(m6), decltype(m7), decltype(m8),
+			       decltype(m9), decltype(m10), decltype(m11),
+			       decltype(m12), decltype(m13), decltype(m14),
+			       decltype(m15), decltype(m16)>{};
+    }
+    using type = decltype(ignore());
+
+    template<class U>
+    static auto tie(U& x) {
+	auto& [m0, m1, m2, m3, m4, m5, m6, m7, m8, m9, m10, m11, m12, m13,
+	       m14, m15, m16] = x;
+	return std::tie(m0, m1, m2, m3, m4, m5, m6, m7, m8, m9, m10, m11,
+			m12, m13, m14, m15, m16);
+    }
+};
+
+template<class T>
+struct aggr_field_type_impl<T, 18> {
+    static auto ignore() {
+	T *x = nullptr;
+	auto [m0, m1, m2, m3, m4, m5, m6, m7, m8, m9, m10, m11, m12, m13,
+	      m14, m15, m16, m17] = *x;
+	return aggr_field_list<decltype(m0), decltype(m1), decltype(m2),
+			       decltype(m3), decltype(m4), decltype(m5),
+			       decltype(m6), decltype(m7), decltype(m8),
+			       decltype(m9), decltype(m10), decltype(m11),
+			       decltype(m12), decltype(m13), decltype(m14),
+			       decltype(m15), decltype(m16), decltype(m17)>{};
+    }
+    using type = decltype(ignore());
+
+    template<class U>
+    static auto tie(U& x) {
+	auto& [m0, m1, m2, m3, m4, m5, m6, m7, m8, m9, m10, m11, m12, m13,
+	       m14, m15, m16, m17] = x;
+	return std::tie(m0, m1, m2, m3, m4, m5, m6, m7, m8, m9, m10, m11,
+			m12, m13, m14, m15, m16, m17);
+    }
+};
+
+template<class T>
+struct aggr_field_type_impl<T, 19> {
+    static auto ignore() {
+	T *x = nullptr;
+	auto [m0, m1, m2, m3, m4, m5, m6, m7, m8, m9, m10, m11, m12, m13,
+	      m14, m15, m16, m17, m18] = *x;
+	return aggr_field_list<decltype(m0), decltype(m1), decltype(m2),
+			       decltype(m3), decltype(m4), decltype(m5),
+			       decltype(m6), decltype(m7), decltype(m8),
+			       decltype(m9), decltype(m10), decltype(m11),
+			       decltype(m12), decltype(m13), decltype(m14),
+			       decltype(m15), decltype(m16), decltype(m17),
+			       decltype(m18)>{};
+    }
+    using type = decltype(ignore());
+
+    template<class U>
+    static auto tie(U& x) {
+	auto& [m0, m1, m2, m3, m4, m5, m6, m7, m8, m9, m10, m11, m12, m13,
+	       m14, m15, m16, m17, m18] = x;
+	return std::tie(m0, m1, m2, m3, m4, m5, m6, m7, m8, m9, m10, m11,
+			m12, m13, m14, m15, m16, m17, m18);
+    }
+};
+
+template<class T>
+struct aggr_field_type_impl<T, 20> {
+    static auto ignore() {
+	T *x = nullptr;
+	auto [m0, m1, m2, m3, m4, m5, m6, m7, m8, m9, m10, m11, m12, m13,
+	      m14, m15, m16, m17, m18, m19] = *x;
+	return aggr_field_list<decltype(m0), decltype(m1), decltype(m2),
+			       decltype(m3), decltype(m4), decltype(m5),
+			       decltype(m6), decltype(m7), decltype(m8),
+			       decltype(m9), decltype(m10), decltype(m11),
+			       decltype(m12), decltype(m13), decltype(m14),
+			       decltype(m15), decltype(m16), decltype(m17),
+			       decltype(m18), decltype(m19)>{};
+    }
+    using type = decltype(ignore());
+
+    template<class U>
+    static auto tie(U& x) {
+	auto& [m0, m1, m2, m3, m4, m5, m6, m7, m8, m9, m10, m11, m12, m13,
+	       m14, m15, m16, m17, m18, m19] = x;
+	return std::tie(m0, m1, m2, m3, m4, m5, m6, m7, m8, m9, m10, m11,
+			m12, m13, m14, m15, m16, m17, m18, m19);
+    }
+};
+
+template<class T>
+struct aggr_field_type_impl<T, 21> {
+    static auto ignore() {
+	T *x = nullptr;
+	auto [m0, m1, m2, m3, m4, m5, m6, m7, m8, m9, m10, m11, m12, m13,
+	      m14, m15, m16, m17, m18, m19, m20] = *x;
+	return aggr_field_list<decltype(m0), decltype(m1), decltype(m2),
+			       decltype(m3), decltype(m4), decltype(m5),
+			       decltype(m6), decltype(m7), decltype(m8),
+			       decltype(m9), decltype(m10), decltype(m11),
+			       decltype(m12), decltype(m13), decltype(m14),
+			       decltype(m15), decltype(m16), decltype(m17),
+			       decltype(m18), decltype(m19), decltype(m20)>{};
+    }
+    using type = decltype(ignore());
+
+    template<class U>
+    static auto tie(U& x) {
+	auto& [m0, m1, m2, m3, m4, m5, m6, m7, m8, m9, m10, m11, m12, m13,
+	       m14, m15, m16, m17, m18, m19, m20] = x;
+	return std::tie(m0, m1, m2, m3, m4, m5, m6, m7, m8, m9, m10, m11,
+			m12, m13, m14, m15, m16, m17, m18, m19, m20);
+    }
+};
+
+template<class T>
+struct aggr_field_type_impl<T, 22> {
+    static auto ignore() {
+	T *x = nullptr;
+	auto [m0, m1, m2, m3, m4, m5, m6, m7, m8, m9, m10, m11, m12, m13,
+	      m14, m15, m16, m17, m18, m19, m20, m21] = *x;
+	return aggr_field_list<decltype(m0), decltype(m1), decltype(m2),
+			       decltype(m3), decltype(m4), decltype(m5),
+			       decltype(m6), decltype(m7), decltype(m8),
+			       decltype(m9), decltype(m10), decltype(m11),
+			       decltype(m12), decltype(m13), decltype(m14),
+			       decltype(m15), decltype(m16), decltype(m17),
+			       decltype(m18), decltype(m19), decltype(m20),
+			       decltype(m21)>{};
+    }
+    using type = decltype(ignore());
+
+    template<class U>
+    static auto tie(U& x) {
+	auto& [m0, m1, m2, m3, m4, m5, m6, m7, m8, m9, m10, m11, m12, m13,
+	       m14, m15, m16, m17, m18, m19, m20, m21] = x;
+	return std::tie(m0, m1, m2, m3, m4, m5, m6, m7, m8, m9, m10, m11,
+			m12, m13, m14, m15, m16, m17, m18, m19, m20, m21);
+    }
+};
+
+template<class T>
+struct aggr_field_type_impl<T, 23> {
+    static auto ignore() {
+	T *x = nullptr;
+	auto [m0, m1, m2, m3, m4, m5, m6, m7, m8, m9, m10, m11, m12, m13,
+	      m14, m15, m16, m17, m18, m19, m20, m21, m22] = *x;
+	return aggr_field_list<decltype(m0), decltype(m1), decltype(m2),
+			       decltype(m3), decltype(m4), decltype(m5),
+			       decltype(m6), decltype(m7), decltype(m8),
+			       decltype(m9), decltype(m10), decltype(m11),
+			       decltype(m12), decltype(m13), decltype(m14),
+			       decltype(m15), decltype(m16), decltype(m17),
+			       decltype(m18), decltype(m19), decltype(m20),
+			       decltype(m21), decltype(m22)>{};
+    }
+    using type = decltype(ignore());
+
+    template<class U>
+    static auto tie(U& x) {
+	auto& [m0, m1, m2, m3, m4, m5, m6, m7, m8, m9, m10, m11, m12, m13,
+	       m14, m15, m16, m17, m18, m19, m20, m21, m22] = x;
+	return std::tie(m0, m1, m2, m3, m4, m5, m6, m7, m8, m9, m10, m11,
+			m12, m13, m14, m15, m16, m17, m18, m19, m20, m21,
+			m22);
+    }
+};
+
+template<class T>
+struct aggr_field_type_impl<T, 24> {
+    static auto ignore() {
+	T *x = nullptr;
+	auto [m0, m1, m2, m3, m4, m5, m6, m7, m8, m9, m10, m11, m12, m13,
+	      m14, m15, m16, m17, m18, m19, m20, m21, m22, m23] = *x;
+	return aggr_field_list<decltype(m0), decltype(m1), decltype(m2),
+			       decltype(m3), decltype(m4), decltype(m5),
+			       decltype(m6), decltype(m7), decltype(m8),
+			       decltype(m9), decltype(m10), decltype(m11),
+			       decltype(m12), decltype(m13), decltype(m14),
+			       decltype(m15), decltype(m16), decltype(m17),
+			       decltype(m18), decltype(m19), decltype(m20),
+			       decltype(m21), decltype(m22), decltype(m23)>{};
+    }
+    using type = decltype(ignore());
+
+    template<class U>
+    static auto tie(U& x) {
+	auto& [m0, m1, m2, m3, m4, m5, m6, m7, m8, m9, m10, m11, m12, m13,
+	       m14, m15, m16, m17, m18, m19, m20, m21, m22, m23] = x;
+	return std::tie(m0, m1, m2, m3, m4, m5, m6, m7, m8, m9, m10, m11,
+			m12, m13, m14, m15, m16, m17, m18, m19, m20, m21,
+			m22, m23);
+    }
+};
+
+template<class T>
+struct aggr_field_type_impl<T, 25> {
+    static auto ignore() {
+	T *x = nullptr;
+	auto [m0, m1, m2, m3, m4, m5, m6, m7, m8, m9, m10, m11, m12, m13,
+	      m14, m15, m16, m17, m18, m19, m20, m21, m22, m23, m24] = *x;
+	return aggr_field_list<decltype(m0), decltype(m1), decltype(m2),
+			       decltype(m3), decltype(m4), decltype(m5),
+			       decltype(m6), decltype(m7), decltype(m8),
+			       decltype(m9), decltype(m10), decltype(m11),
+			       decltype(m12), decltype(m13), decltype(m14),
+			       decltype(m15), decltype(m16), decltype(m17),
+			       decltype(m18), decltype(m19), decltype(m20),
+			       decltype(m21), decltype(m22), decltype(m23),
+			       decltype(m24)>{};
+    }
+    using type = decltype(ignore());
+
+    template<class U>
+    static auto tie(U& x) {
+	auto& [m0, m1, m2, m3, m4, m5, m6, m7, m8, m9, m10, m11, m12, m13,
+	       m14, m15, m16, m17, m18, m19, m20, m21, m22, m23, m24] = x;
+	return std::tie(m0, m1, m2, m3, m4, m5, m6, m7, m8, m9, m10, m11,
+			m12, m13, m14, m15, m16, m17, m18, m19, m20, m21,
+			m22, m23, m24);
+    }
+};
+
+template<class T>
+struct aggr_field_type_impl<T, 26> {
+    static auto ignore() {
+	T *x = nullptr;
+	auto [m0, m1, m2, m3, m4, m5, m6, m7, m8, m9, m10, m11, m12, m13,
+	      m14, m15, m16, m17, m18, m19, m20, m21, m22, m23, m24, m25] = *x;
+	return aggr_field_list<decltype(m0), decltype(m1), decltype(m2),
+			       decltype(m3), decltype(m4), decltype(m5),
+			       decltype(m6), decltype(m7), decltype(m8),
+			       decltype(m9), decltype(m10), decltype(m11),
+			       decltype(m12), decltype(m13), decltype(m14),
+			       decltype(m15), decltype(m16), decltype(m17),
+			       decltype(m18), decltype(m19), decltype(m20),
+			       decltype(m21), decltype(m22), decltype(m23),
+			       decltype(m24), decltype(m25)>{};
+    }
+    using type = decltype(ignore());
+
+    template<class U>
+    static auto tie(U& x) {
+	auto& [m0, m1, m2, m3, m4, m5, m6, m7, m8, m9, m10, m11, m12, m13,
+	       m14, m15, m16, m17, m18, m19, m20, m21, m22, m23, m24, m25] = x;
+	return std::tie(m0, m1, m2, m3, m4, m5, m6, m7, m8, m9, m10, m11,
+			m12, m13, m14, m15, m16, m17, m18, m19, m20, m21,
+			m22, m23, m24, m25);
+    }
+};
+
+template<class T>
+struct aggr_field_type_impl<T, 27> {
+    static auto ignore() {
+	T *x = nullptr;
+	auto [m0, m1, m2, m3, m4, m5, m6, m7, m8, m9, m10, m11, m12, m13,
+	      m14, m15, m16, m17, m18, m19, m20, m21, m22, m23, m24, m25,
+	      m26] = *x;
+	return aggr_field_list<decltype(m0), decltype(m1), decltype(m2),
+			       decltype(m3), decltype(m4), decltype(m5),
+			       decltype(m6), decltype(m7), decltype(m8),
+			       decltype(m9), decltype(m10), decltype(m11),
+			       decltype(m12), decltype(m13), decltype(m14),
+			       decltype(m15), decltype(m16), decltype(m17),
+			       decltype(m18), decltype(m19), decltype(m20),
+			       decltype(m21), decltype(m22), decltype(m23),
+			       decltype(m24), decltype(m25), decltype(m26)>{};
+    }
+    using type = decltype(ignore());
+
+    template<class U>
+    static auto tie(U& x) {
+	auto& [m0, m1, m2, m3, m4, m5, m6, m7, m8, m9, m10, m11, m12, m13,
+	       m14, m15, m16, m17, m18, m19, m20, m21, m22, m23, m24, m25,
+	       m26] = x;
+	return std::tie(m0, m1, m2, m3, m4, m5, m6, m7, m8, m9, m10, m11,
+			m12, m13, m14, m15, m16, m17, m18, m19, m20, m21,
+			m22, m23, m24, m25, m26);
+    }
+};
+
+template<class T>
+struct aggr_field_type_impl<T, 28> {
+    static auto ignore() {
+	T *x = nullptr;
+	auto [m0, m1, m2, m3, m4, m5, m6, m7, m8, m9, m10, m11, m12, m13,
+	      m14, m15, m16, m17, m18, m19, m20, m21, m22, m23, m24, m25,
+	      m26, m27] = *x;
+	return aggr_field_list<decltype(m0), decltype(m1), decltype(m2),
+			       decltype(m3), decltype(m4), decltype(m5),
+			       decltype(m6), decltype(m7), decltype(m8),
+			       decltype(m9), decltype(m10), decltype(m11),
+			       decltype(m12), decltype(m13), decltype(m14),
+			       decltype(m15), decltype(m16), decltype(m17),
+			       decltype(m18), decltype(m19), decltype(m20),
+			       decltype(m21), decltype(m22), decltype(m23),
+			       decltype(m24), decltype(m25), decltype(m26),
+			       decltype(m27)>{};
+    }
+    using type = decltype(ignore());
+
+    template<class U>
+    static auto tie(U& x) {
+	auto& [m0, m1, m2, m3, m4, m5, m6, m7, m8, m9, m10, m11, m12, m13,
+	       m14, m15, m16, m17, m18, m19, m20, m21, m22, m23, m24, m25,
+	       m26, m27] = x;
+	return std::tie(m0, m1, m2, m3, m4, m5, m6, m7, m8, m9, m10, m11,
+			m12, m13, m14, m15, m16, m17, m18, m19, m20, m21,
+			m22, m23, m24, m25, m26, m27);
+    }
+};
+
+template<class T>
+struct aggr_field_type_impl<T, 29> {
+    static auto ignore() {
+	T *x = nullptr;
+	auto [m0, m1, m2, m3, m4, m5, m6, m7, m8, m9, m10, m11, m12, m13,
+	      m14, m15, m16, m17, m18, m19, m20, m21, m22, m23, m24, m25,
+	      m26, m27, m28] = *x;
+	return aggr_field_list<decltype(m0), decltype(m1), decltype(m2),
+			       decltype(m3), decltype(m4), decltype(m5),
+			       decltype(m6), decltype(m7), decltype(m8),
+			       decltype(m9), decltype(m10), decltype(m11),
+			       decltype(m12), decltype(m13), decltype(m14),
+			       decltype(m15), decltype(m16), decltype(m17),
+			       decltype(m18), decltype(m19), decltype(m20),
+			       decltype(m21), decltype(m22), decltype(m23),
+			       decltype(m24), decltype(m25), decltype(m26),
+			       decltype(m27), decltype(m28)>{};
+    }
+    using type = decltype(ignore());
+
+    template<class U>
+    static auto tie(U& x) {
+	auto& [m0, m1, m2, m3, m4, m5, m6, m7, m8, m9, m10, m11, m12, m13,
+	       m14, m15, m16, m17, m18, m19, m20, m21, m22, m23, m24, m25,
+	       m26, m27, m28] = x;
+	return std::tie(m0, m1, m2, m3, m4, m5, m6, m7, m8, m9, m10, m11,
+			m12, m13, m14, m15, m16, m17, m18, m19, m20, m21,
+			m22, m23, m24, m25, m26, m27, m28);
+    }
+};
+
+template<class T>
+struct aggr_field_type_impl<T, 30> {
+    static auto ignore() {
+	T *x = nullptr;
+	auto [m0, m1, m2, m3, m4, m5, m6, m7, m8, m9, m10, m11, m12, m13,
+	      m14, m15, m16, m17, m18, m19, m20, m21, m22, m23, m24, m25,
+	      m26, m27, m28, m29] = *x;
+	return aggr_field_list<decltype(m0), decltype(m1), decltype(m2),
+			       decltype(m3), decltype(m4), decltype(m5),
+			       decltype(m6), decltype(m7), decltype(m8),
+			       decltype(m9), decltype(m10), decltype(m11),
+			       decltype(m12), decltype(m13), decltype(m14),
+			       decltype(m15), decltype(m16), decltype(m17),
+			       decltype(m18), decltype(m19), decltype(m20),
+			       decltype(m21), decltype(m22), decltype(m23),
+			       decltype(m24), decltype(m25), decltype(m26),
+			       decltype(m27), decltype(m28), decltype(m29)>{};
+    }
+    using type = decltype(ignore());
+
+    template<class U>
+    static auto tie(U& x) {
+	auto& [m0, m1, m2, m3, m4, m5, m6, m7, m8, m9, m10, m11, m12, m13,
+	       m14, m15, m16, m17, m18, m19, m20, m21, m22, m23, m24, m25,
+	       m26, m27, m28, m29] = x;
+	return std::tie(m0, m1, m2, m3, m4, m5, m6, m7, m8, m9, m10, m11,
+			m12, m13, m14, m15, m16, m17, m18, m19, m20, m21,
+			m22, m23, m24, m25, m26, m27, m28, m29);
+    }
+};
+
+template<class T>
+struct aggr_field_type_impl<T, 31> {
+    static auto ignore() {
+	T *x = nullptr;
+	auto [m0, m1, m2, m3, m4, m5, m6, m7, m8, m9, m10, m11, m12, m13,
+	      m14, m15, m16, m17, m18, m19, m20, m21, m22, m23, m24, m25,
+	      m26, m27, m28, m29, m30] = *x;
+	return aggr_field_list<decltype(m0), decltype(m1), decltype(m2),
+			       decltype(m3), decltype(m4), decltype(m5),
+			       decltype(m6), decltype(m7), decltype(m8),
+			       decltype(m9), decltype(m10), decltype(m11),
+			       decltype(m12), decltype(m13), decltype(m14),
+			       decltype(m15), decltype(m16), decltype(m17),
+			       decltype(m18), decltype(m19), decltype(m20),
+			       decltype(m21), decltype(m22), decltype(m23),
+			       decltype(m24), decltype(m25), decltype(m26),
+			       decltype(m27), decltype(m28), decltype(m29),
+			       decltype(m30)>{};
+    }
+    using type = decltype(ignore());
+
+    template<class U>
+    static auto tie(U& x) {
+	auto& [m0, m1, m2, m3, m4, m5, m6, m7, m8, m9, m10, m11, m12, m13,
+	       m14, m15, m16, m17, m18, m19, m20, m21, m22, m23, m24, m25,
+	       m26, m27, m28, m29, m30] = x;
+	return std::tie(m0, m1, m2, m3, m4, m5, m6, m7, m8, m9, m10, m11,
+			m12, m13, m14, m15, m16, m17, m18, m19, m20, m21,
+			m22, m23, m24, m25, m26, m27, m28, m29, m30);
+    }
+};
+
+template<class T>
+struct aggr_field_type_impl<T, 32> {
+    static auto ignore() {
+	T *x = nullptr;
+	auto [m0, m1, m2, m3, m4, m5, m6, m7, m8, m9, m10, m11, m12, m13,
+	      m14, m15, m16, m17, m18, m19, m20, m21, m22, m23, m24, m25,
+	      m26, m27, m28, m29, m30, m31] = *x;
+	return aggr_field_list<decltype(m0), decltype(m1), decltype(m2),
+			       decltype(m3), decltype(m4), decltype(m5),
+			       decltype(m6), decltype(m7), decltype(m8),
+			       decltype(m9), decltype(m10), decltype(m11),
+			       decltype(m12), decltype(m13), decltype(m14),
+			       decltype(m15), decltype(m16), decltype(m17),
+			       decltype(m18), decltype(m19), decltype(m20),
+			       decltype(m21), decltype(m22), decltype(m23),
+			       decltype(m24), decltype(m25), decltype(m26),
+			       decltype(m27), decltype(m28), decltype(m29),
+			       decltype(m30), decltype(m31)>{};
+    }
+    using type = decltype(ignore());
+
+    template<class U>
+    static auto tie(U& x) {
+	auto& [m0, m1, m2, m3, m4, m5, m6, m7, m8, m9, m10, m11, m12, m13,
+	       m14, m15, m16, m17, m18, m19, m20, m21, m22, m23, m24, m25,
+	       m26, m27, m28, m29, m30, m31] = x;
+	return std::tie(m0, m1, m2, m3, m4, m5, m6, m7, m8, m9, m10, m11,
+			m12, m13, m14, m15, m16, m17, m18, m19, m20, m21,
+			m22, m23, m24, m25, m26, m27, m28, m29, m30, m31);
+    }
+};
+
+template<class T>
+struct aggr_field_type_impl<T, 33> {
+    static auto ignore() {
+	T *x = nullptr;
+	auto [m0, m1, m2, m3, m4, m5, m6, m7, m8, m9, m10, m11, m12, m13,
+	      m14, m15, m16, m17, m18, m19, m20, m21, m22, m23, m24, m25,
+	      m26, m27, m28, m29, m30, m31, m32] = *x;
+	return aggr_field_list<decltype(m0), decltype(m1), decltype(m2),
+			       decltype(m3), decltype(m4), decltype(m5),
+			       decltype(m6), decltype(m7), decltype(m8),
+			       decltype(m9), decltype(m10), decltype(m11),
+			       decltype(m12), decltype(m13), decltype(m14),
+			       decltype(m15), decltype(m16), decltype(m17),
+			       decltype(m18), decltype(m19), decltype(m20),
+			       decltype(m21), decltype(m22), decltype(m23),
+			       decltype(m24), decltype(m25), decltype(m26),
+			       decltype(m27), decltype(m28), decltype(m29),
+			       decltype(m30), decltype(m31), decltype(m32)>{};
+    }
+    using type = decltype(ignore());
+
+    template<class U>
+    static auto tie(U& x) {
+	auto& [m0, m1, m2, m3, m4, m5, m6, m7, m8, m9, m10, m11, m12, m13,
+	       m14, m15, m16, m17, m18, m19, m20, m21, m22, m23, m24, m25,
+	       m26, m27, m28, m29, m30, m31, m32] = x;
+	return std::tie(m0, m1, m2, m3, m4, m5, m6, m7, m8, m9, m10, m11,
+			m12, m13, m14, m15, m16, m17, m18, m19, m20, m21,
+			m22, m23, m24, m25, m26, m27, m28, m29, m30, m31,
+			m32);
+    }
+};
+
+template<class T>
+struct aggr_field_type_impl<T, 34> {
+    static auto ignore() {
+	T *x = nullptr;
+	auto [m0, m1, m2, m3, m4, m5, m6, m7, m8, m9, m10, m11, m12, m13,
+	      m14, m15, m16, m17, m18, m19, m20, m21, m22, m23, m24, m25,
+	      m26, m27, m28, m29, m30, m31, m32, m33] = *x;
+	return aggr_field_list<decltype(m0), decltype(m1), decltype(m2),
+			       decltype(m3), decltype(m4), decltype(m5),
+			       decltype(m6), decltype(m7), decltype(m8),
+			       decltype(m9), decltype(m10), decltype(m11),
+			       decltype(m12), decltype(m13), decltype(m14),
+			       decltype(m15), decltype(m16), decltype(m17),
+			       decltype(m18), decltype(m19), decltype(m20),
+			       decltype(m21), decltype(m22), decltype(m23),
+			       decltype(m24), decltype(m25), decltype(m26),
+			       decltype(m27), decltype(m28), decltype(m29),
+			       decltype(m30), decltype(m31), decltype(m32),
+			       decltype(m33)>{};
+    }
+    using type = decltype(ignore());
+
+    template<class U>
+    static auto tie(U& x) {
+	auto& [m0, m1, m2, m3, m4, m5, m6, m7, m8, m9, m10, m11, m12, m13,
+	       m14, m15, m16, m17, m18, m19, m20, m21, m22, m23, m24, m25,
+	       m26, m27, m28, m29, m30, m31, m32, m33] = x;
+	return std::tie(m0, m1, m2, m3, m4, m5, m6, m7, m8, m9, m10, m11,
+			m12, m13, m14, m15, m16, m17, m18, m19, m20, m21,
+			m22, m23, m24, m25, m26, m27, m28, m29, m30, m31,
+			m32, m33);
+    }
+};
+
+template<class T>
+struct aggr_field_type_impl<T, 35> {
+    static auto ignore() {
+	T *x = nullptr;
+	auto [m0, m1, m2, m3, m4, m5, m6, m7, m8, m9, m10, m11, m12, m13,
+	      m14, m15, m16, m17, m18, m19, m20, m21, m22, m23, m24, m25,
+	      m26, m27, m28, m29, m30, m31, m32, m33, m34] = *x;
+	return aggr_field_list<decltype(m0), decltype(m1), decltype(m2),
+			       decltype(m3), decltype(m4), decltype(m5),
+			       decltype(m6), decltype(m7), decltype(m8),
+			       decltype(m9), decltype(m10), decltype(m11),
+			       decltype(m12), decltype(m13), decltype(m14),
+			       decltype(m15), decltype(m16), decltype(m17),
+			       decltype(m18), decltype(m19), decltype(m20),
+			       decltype(m21), decltype(m22), decltype(m23),
+			       decltype(m24), decltype(m25), decltype(m26),
+			       decltype(m27), decltype(m28), decltype(m29),
+			       decltype(m30), decltype(m31), decltype(m32),
+			       decltype(m33), decltype(m34)>{};
+    }
+    using type = decltype(ignore());
+
+    template<class U>
+    static auto tie(U& x) {
+	auto& [m0, m1, m2, m3, m4, m5, m6, m7, m8, m9, m10, m11, m12, m13,
+	       m14, m15, m16, m17, m18, m19, m20, m21, m22, m23, m24, m25,
+	       m26, m27, m28, m29, m30, m31, m32, m33, m34] = x;
+	return std::tie(m0, m1, m2, m3, m4, m5, m6, m7, m8, m9, m10, m11,
+			m12, m13, m14, m15, m16, m17, m18, m19, m20, m21,
+			m22, m23, m24, m25, m26, m27, m28, m29, m30, m31,
+			m32, m33, m34);
+    }
+};
+
+template<class T>
+struct aggr_field_type_impl<T, 36> {
+    static auto ignore() {
+	T *x = nullptr;
+	auto [m0, m1, m2, m3, m4, m5, m6, m7, m8, m9, m10, m11, m12, m13,
+	      m14, m15, m16, m17, m18, m19, m20, m21, m22, m23, m24, m25,
+	      m26, m27, m28, m29, m30, m31, m32, m33, m34, m35] = *x;
+	return aggr_field_list<decltype(m0), decltype(m1), decltype(m2),
+			       decltype(m3), decltype(m4), decltype(m5),
+			       decltype(m6), decltype(m7), decltype(m8),
+			       decltype(m9), decltype(m10), decltype(m11),
+			       decltype(m12), decltype(m13), decltype(m14),
+			       decltype(m15), decltype(m16), decltype(m17),
+			       decltype(m18), decltype(m19), decltype(m20),
+			       decltype(m21), decltype(m22), decltype(m23),
+			       decltype(m24), decltype(m25), decltype(m26),
+			       decltype(m27), decltype(m28), decltype(m29),
+			       decltype(m30), decltype(m31), decltype(m32),
+			       decltype(m33), decltype(m34), decltype(m35)>{};
+    }
+    using type = decltype(ignore());
+
+    template<class U>
+    static auto tie(U& x) {
+	auto& [m0, m1, m2, m3, m4, m5, m6, m7, m8, m9, m10, m11, m12, m13,
+	       m14, m15, m16, m17, m18, m19, m20, m21, m22, m23, m24, m25,
+	       m26, m27, m28, m29, m30, m31, m32, m33, m34, m35] = x;
+	return std::tie(m0, m1, m2, m3, m4, m5, m6, m7, m8, m9, m10, m11,
+			m12, m13, m14, m15, m16, m17, m18, m19, m20, m21,
+			m22, m23, m24, m25, m26, m27, m28, m29, m30, m31,
+			m32, m33, m34, m35);
+    }
+};
+
+template<class T>
+struct aggr_field_type_impl<T, 37> {
+    static auto ignore() {
+	T *x = nullptr;
+	auto [m0, m1, m2, m3, m4, m5, m6, m7, m8, m9, m10, m11, m12, m13,
+	      m14, m15, m16, m17, m18, m19, m20, m21, m22, m23, m24, m25,
+	      m26, m27, m28, m29, m30, m31, m32, m33, m34, m35, m36] = *x;
+	return aggr_field_list<decltype(m0), decltype(m1), decltype(m2),
+			       decltype(m3), decltype(m4), decltype(m5),
+			       decltype(m6), decltype(m7), decltype(m8),
+			       decltype(m9), decltype(m10), decltype(m11),
+			       decltype(m12), decltype(m13), decltype(m14),
+			       decltype(m15), decltype(m16), decltype(m17),
+			       decltype(m18), decltype(m19), decltype(m20),
+			       decltype(m21), decltype(m22), decltype(m23),
+			       decltype(m24), decltype(m25), decltype(m26),
+			       decltype(m27), decltype(m28), decltype(m29),
+			       decltype(m30), decltype(m31), decltype(m32),
+			       decltype(m33), decltype(m34), decltype(m35),
+			       decltype(m36)>{};
+    }
+    using type = decltype(ignore());
+
+    template<class U>
+    static auto tie(U& x) {
+	auto& [m0, m1, m2, m3, m4, m5, m6, m7, m8, m9, m10, m11, m12, m13,
+	       m14, m15, m16, m17, m18, m19, m20, m21, m22, m23, m24, m25,
+	       m26, m27, m28, m29, m30, m31, m32, m33, m34, m35, m36] = x;
+	return std::tie(m0, m1, m2, m3, m4, m5, m6, m7, m8, m9, m10, m11,
+			m12, m13, m14, m15, m16, m17, m18, m19, m20, m21,
+			m22, m23, m24, m25, m26, m27, m28, m29, m30, m31,
+			m32, m33, m34, m35, m36);
+    }
+};
+
+template<class T>
+struct aggr_field_type_impl<T, 38> {
+    static auto ignore() {
+	T *x = nullptr;
+	auto [m0, m1, m2, m3, m4, m5, m6, m7, m8, m9, m10, m11, m12, m13,
+	      m14, m15, m16, m17, m18, m19, m20, m21, m22, m23, m24, m25,
+	      m26, m27, m28, m29, m30, m31, m32, m33, m34, m35, m36, m37] = *x;
+	return aggr_field_list<decltype(m0), decltype(m1), decltype(m2),
+			       decltype(m3), decltype(m4), decltype(m5),
+			       decltype(m6), decltype(m7), decltype(m8),
+			       decltype(m9), decltype(m10), decltype(m11),
+			       decltype(m12), decltype(m13), decltype(m14),
+			       decltype(m15), decltype(m16), decltype(m17),
+			       decltype(m18), decltype(m19), decltype(m20),
+			       decltype(m21), decltype(m22), decltype(m23),
+			       decltype(m24), decltype(m25), decltype(m26),
+			       decltype(m27), decltype(m28), decltype(m29),
+			       decltype(m30), decltype(m31), decltype(m32),
+			       decltype(m33), decltype(m34), decltype(m35),
+			       decltype(m36), decltype(m37)>{};
+    }
+    using type = decltype(ignore());
+
+    template<class U>
+    static auto tie(U& x) {
+	auto& [m0, m1, m2, m3, m4, m5, m6, m7, m8, m9, m10, m11, m12, m13,
+	       m14, m15, m16, m17, m18, m19, m20, m21, m22, m23, m24, m25,
+	       m26, m27, m28, m29, m30, m31, m32, m33, m34, m35, m36, m37] = x;
+	return std::tie(m0, m1, m2, m3, m4, m5, m6, m7, m8, m9, m10, m11,
+			m12, m13, m14, m15, m16, m17, m18, m19, m20, m21,
+			m22, m23, m24, m25, m26, m27, m28, m29, m30, m31,
+			m32, m33, m34, m35, m36, m37);
+    }
+};
+
+template<class T>
+struct aggr_field_type_impl<T, 39> {
+    static auto ignore() {
+	T *x = nullptr;
+	auto [m0, m1, m2, m3, m4, m5, m6, m7, m8, m9, m10, m11, m12, m13,
+	      m14, m15, m16, m17, m18, m19, m20, m21, m22, m23, m24, m25,
+	      m26, m27, m28, m29, m30, m31, m32, m33, m34, m35, m36, m37,
+	      m38] = *x;
+	return aggr_field_list<decltype(m0), decltype(m1), decltype(m2),
+			       decltype(m3), decltype(m4), decltype(m5),
+			       decltype(m6), decltype(m7), decltype(m8),
+			       decltype(m9), decltype(m10), decltype(m11),
+			       decltype(m12), decltype(m13), decltype(m14),
+			       decltype(m15), decltype(m16), decltype(m17),
+			       decltype(m18), decltype(m19), decltype(m20),
+			       decltype(m21), decltype(m22), decltype(m23),
+			       decltype(m24), decltype(m25), decltype(m26),
+			       decltype(m27), decltype(m28), decltype(m29),
+			       decltype(m30), decltype(m31), decltype(m32),
+			       decltype(m33), decltype(m34), decltype(m35),
+			       decltype(m36), decltype(m37), decltype(m38)>{};
+    }
+    using type = decltype(ignore());
+
+    template<class U>
+    static auto tie(U& x) {
+	auto& [m0, m1, m2, m3, m4, m5, m6, m7, m8, m9, m10, m11, m12, m13,
+	       m14, m15, m16, m17, m18, m19, m20, m21, m22, m23, m24, m25,
+	       m26, m27, m28, m29, m30, m31, m32, m33, m34, m35, m36, m37,
+	       m38] = x;
+	return std::tie(m0, m1, m2, m3, m4, m5, m6, m7, m8, m9, m10, m11,
+			m12, m13, m14, m15, m16, m17, m18, m19, m20, m21,
+			m22, m23, m24, m25, m26, m27, m28, m29, m30, m31,
+			m32, m33, m34, m35, m36, m37, m38);
+    }
+};
+
+template<class T>
+struct aggr_field_type_impl<T, 40> {
+    static auto ignore() {
+	T *x = nullptr;
+	auto [m0, m1, m2, m3, m4, m5, m6, m7, m8, m9, m10, m11, m12, m13,
+	      m14, m15, m16, m17, m18, m19, m20, m21, m22, m23, m24, m25,
+	      m26, m27, m28, m29, m30, m31, m32, m33, m34, m35, m36, m37,
+	      m38, m39] = *x;
+	return aggr_field_list<decltype(m0), decltype(m1), decltype(m2),
+			       decltype(m3), decltype(m4), decltype(m5),
+			       decltype(m6), decltype(m7), decltype(m8),
+			       decltype(m9), decltype(m10), decltype(m11),
+			       decltype(m12), decltype(m13), decltype(m14),
+			       decltype(m15), decltype(m16), decltype(m17),
+			       decltype(m18), decltype(m19), decltype(m20),
+			       decltype(m21), decltype(m22), decltype(m23),
+			       decltype(m24), decltype(m25), decltype(m26),
+			       decltype(m27), decltype(m28), decltype(m29),
+			       decltype(m30), decltype(m31), decltype(m32),
+			       decltype(m33), decltype(m34), decltype(m35),
+			       decltype(m36), decltype(m37), decltype(m38),
+			       decltype(m39)>{};
+    }
+    using type = decltype(ignore());
+
+    template<class U>
+    static auto tie(U& x) {
+	auto& [m0, m1, m2, m3, m4, m5, m6, m7, m8, m9, m10, m11, m12, m13,
+	       m14, m15, m16, m17, m18, m19, m20, m21, m22, m23, m24, m25,
+	       m26, m27, m28, m29, m30, m31, m32, m33, m34, m35, m36, m37,
+	       m38, m39] = x;
+	return std::tie(m0, m1, m2, m3, m4, m5, m6, m7, m8, m9, m10, m11,
+			m12, m13, m14, m15, m16, m17, m18, m19, m20, m21,
+			m22, m23, m24, m25, m26, m27, m28, m29, m30, m31,
+			m32, m33, m34, m35, m36, m37, m38, m39);
+    }
+};
+
+template<class T>
+struct aggr_field_type_impl<T, 41> {
+    static auto ignore() {
+	T *x = nullptr;
+	auto [m0, m1, m2, m3, m4, m5, m6, m7, m8, m9, m10, m11, m12, m13,
+	      m14, m15, m16, m17, m18, m19, m20, m21, m22, m23, m24, m25,
+	      m26, m27, m28, m29, m30, m31, m32, m33, m34, m35, m36, m37,
+	      m38, m39, m40] = *x;
+	return aggr_field_list<decltype(m0), decltype(m1), decltype(m2),
+			       decltype(m3), decltype(m4), decltype(m5),
+			       decltype(m6), decltype(m7), decltype(m8),
+			       decltype(m9), decltype(m10), decltype(m11),
+			       decltype(m12), decltype(m13), decltype(m14),
+			       decltype(m15), decltype(m16), decltype(m17),
+			       decltype(m18), decltype(m19), decltype(m20),
+			       decltype(m21), decltype(m22), decltype(m23),
+			       decltype(m24), decltype(m25), decltype(m26),
+			       decltype(m27), decltype(m28), decltype(m29),
+			       decltype(m30), decltype(m31), decltype(m32),
+			       decltype(m33), decltype(m34), decltype(m35),
+			       decltype(m36), decltype(m37), decltype(m38),
+			       decltype(m39), decltype(m40)>{};
+    }
+    using type = decltype(ignore());
+
+    template<class U>
+    static auto tie(U& x) {
+	auto& [m0, m1, m2, m3, m4, m5, m6, m7, m8, m9, m10, m11, m12, m13,
+	       m14, m15, m16, m17, m18, m19, m20, m21, m22, m23, m24, m25,
+	       m26, m27, m28, m29, m30, m31, m32, m33, m34, m35, m36, m37,
+	       m38, m39, m40] = x;
+	return std::tie(m0, m1, m2, m3, m4, m5, m6, m7, m8, m9, m10, m11,
+			m12, m13, m14, m15, m16, m17, m18, m19, m20, m21,
+			m22, m23, m24, m25, m26, m27, m28, m29, m30, m31,
+			m32, m33, m34, m35, m36, m37, m38, m39, m40);
+    }
+};
+
+template<class T>
+struct aggr_field_type_impl<T, 42> {
+    static auto ignore() {
+	T *x = nullptr;
+	auto [m0, m1, m2, m3, m4, m5, m6, m7, m8, m9, m10, m11, m12, m13,
+	      m14, m15, m16, m17, m18, m19, m20, m21, m22, m23, m24, m25,
+	      m26, m27, m28, m29, m30, m31, m32, m33, m34, m35, m36, m37,
+	      m38, m39, m40, m41] = *x;
+	return aggr_field_list<decltype(m0), decltype(m1), decltype(m2),
+			       decltype(m3), decltype(m4), decltype(m5),
+			       decltype(m6), decltype(m7), decltype(m8),
+			       decltype(m9), decltype(m10), decltype(m11),
+			       decltype(m12), decltype(m13), decltype(m14),
+			       decltype(m15), decltype(m16), decltype(m17),
+			       decltype(m18), decltype(m19), decltype(m20),
+			       decltype(m21), decltype(m22), decltype(m23),
+			       decltype(m24), decltype(m25), decltype(m26),
+			       decltype(m27), decltype(m28), decltype(m29),
+			       decltype(m30), decltype(m31), decltype(m32),
+			       decltype(m33), decltype(m34), decltype(m35),
+			       decltype(m36), decltype(m37), decltype(m38),
+			       decltype(m39), decltype(m40), decltype(m41)>{};
+    }
+    using type = decltype(ignore());
+
+    template<class U>
+    static auto tie(U& x) {
+	auto& [m0, m1, m2, m3, m4, m5, m6, m7, m8, m9, m10, m11, m12, m13,
+	       m14, m15, m16, m17, m18, m19, m20, m21, m22, m23, m24, m25,
+	       m26, m27, m28, m29, m30, m31, m32, m33, m34, m35, m36, m37,
+	       m38, m39, m40, m41] = x;
+	return std::tie(m0, m1, m2, m3, m4, m5, m6, m7, m8, m9, m10, m11,
+			m12, m13, m14, m15, m16, m17, m18, m19, m20, m21,
+			m22, m23, m24, m25, m26, m27, m28, m29, m30, m31,
+			m32, m33, m34, m35, m36, m37, m38, m39, m40, m41);
+    }
+};
+
+template<class T>
+struct aggr_field_type_impl<T, 43> {
+    static auto ignore() {
+	T *x = nullptr;
+	auto [m0, m1, m2, m3, m4, m5, m6, m7, m8, m9, m10, m11, m12, m13,
+	      m14, m15, m16, m17, m18, m19, m20, m21, m22, m23, m24, m25,
+	      m26, m27, m28, m29, m30, m31, m32, m33, m34, m35, m36, m37,
+	      m38, m39, m40, m41, m42] = *x;
+	return aggr_field_list<decltype(m0), decltype(m1), decltype(m2),
+			       decltype(m3), decltype(m4), decltype(m5),
+			       decltype(m6), decltype(m7), decltype(m8),
+			       decltype(m9), decltype(m10), decltype(m11),
+			       decltype(m12), decltype(m13), decltype(m14),
+			       decltype(m15), decltype(m16), decltype(m17),
+			       decltype(m18), decltype(m19), decltype(m20),
+			       decltype(m21), decltype(m22), decltype(m23),
+			       decltype(m24), decltype(m25), decltype(m26),
+			       decltype(m27), decltype(m28), decltype(m29),
+			       decltype(m30), decltype(m31), decltype(m32),
+			       decltype(m33), decltype(m34), decltype(m35),
+			       decltype(m36), decltype(m37), decltype(m38),
+			       decltype(m39), decltype(m40), decltype(m41),
+			       decltype(m42)>{};
+    }
+    using type = decltype(ignore());
+
+    template<class U>
+    static auto tie(U& x) {
+	auto& [m0, m1, m2, m3, m4, m5, m6, m7, m8, m9, m10, m11, m12, m13,
+	       m14, m15, m16, m17, m18, m19, m20, m21, m22, m23, m24, m25,
+	       m26, m27, m28, m29, m30, m31, m32, m33, m34, m35, m36, m37,
+	       m38, m39, m40, m41, m42] = x;
+	return std::tie(m0, m1, m2, m3, m4, m5, m6, m7, m8, m9, m10, m11,
+			m12, m13, m14, m15, m16, m17, m18, m19, m20, m21,
+			m22, m23, m24, m25, m26, m27, m28, m29, m30, m31,
+			m32, m33, m34, m35, m36, m37, m38, m39, m40, m41,
+			m42);
+    }
+};
+
+template<class T>
+struct aggr_field_type_impl<T, 44> {
+    static auto ignore() {
+	T *x = nullptr;
+	auto [m0, m1, m2, m3, m4, m5, m6, m7, m8, m9, m10, m11, m12, m13,
+	      m14, m15, m16, m17, m18, m19, m20, m21, m22, m23, m24, m25,
+	      m26, m27, m28, m29, m30, m31, m32, m33, m34, m35, m36, m37,
+	      m38, m39, m40, m41, m42, m43] = *x;
+	return aggr_field_list<decltype(m0), decltype(m1), decltype(m2),
+			       decltype(m3), decltype(m4), decltype(m5),
+			       decltype(m6), decltype(m7), decltype(m8),
+			       decltype(m9), decltype(m10), decltype(m11),
+			       decltype(m12), decltype(m13), decltype(m14),
+			       decltype(m15), decltype(m16), decltype(m17),
+			       decltype(m18), decltype(m19), decltype(m20),
+			       decltype(m21), decltype(m22), decltype(m23),
+			       decltype(m24), decltype(m25), decltype(m26),
+			       decltype(m27), decltype(m28), decltype(m29),
+			       decltype(m30), decltype(m31), decltype(m32),
+			       decltype(m33), decltype(m34), decltype(m35),
+			       decltype(m36), decltype(m37), decltype(m38),
+			       decltype(m39), decltype(m40), decltype(m41),
+			       decltype(m42), decltype(m43)>{};
+    }
+    using type = decltype(ignore());
+
+    template<class U>
+    static auto tie(U& x) {
+	auto& [m0, m1, m2, m3, m4, m5, m6, m7, m8, m9, m10, m11, m12, m13,
+	       m14, m15, m16, m17, m18, m19, m20, m21, m22, m23, m24, m25,
+	       m26, m27, m28, m29, m30, m31, m32, m33, m34, m35, m36, m37,
+	       m38, m39, m40, m41, m42, m43] = x;
+	return std::tie(m0, m1, m2, m3, m4, m5, m6, m7, m8, m9, m10, m11,
+			m12, m13, m14, m15, m16, m17, m18, m19, m20, m21,
+			m22, m23, m24, m25, m26, m27, m28, m29, m30, m31,
+			m32, m33, m34, m35, m36, m37, m38, m39, m40, m41,
+			m42, m43);
+    }
+};
+
+template<class T>
+struct aggr_field_type_impl<T, 45> {
+    static auto ignore() {
+	T *x = nullptr;
+	auto [m0, m1, m2, m3, m4, m5, m6, m7, m8, m9, m10, m11, m12, m13,
+	      m14, m15, m16, m17, m18, m19, m20, m21, m22, m23, m24, m25,
+	      m26, m27, m28, m29, m30, m31, m32, m33, m34, m35, m36, m37,
+	      m38, m39, m40, m41, m42, m43, m44] = *x;
+	return aggr_field_list<decltype(m0), decltype(m1), decltype(m2),
+			       decltype(m3), decltype(m4), decltype(m5),
+			       decltype(m6), decltype(m7), decltype(m8),
+			       decltype(m9), decltype(m10), decltype(m11),
+			       decltype(m12), decltype(m13), decltype(m14),
+			       decltype(m15), decltype(m16), decltype(m17),
+			       decltype(m18), decltype(m19), decltype(m20),
+			       decltype(m21), decltype(m22), decltype(m23),
+			       decltype(m24), decltype(m25), decltype(m26),
+			       decltype(m27), decltype(m28), decltype(m29),
+			       decltype(m30), decltype(m31), decltype(m32),
+			       decltype(m33), decltype(m34), decltype(m35),
+			       decltype(m36), decltype(m37), decltype(m38),
+			       decltype(m39), decltype(m40), decltype(m41),
+			       decltype(m42), decltype(m43), decltype(m44)>{};
+    }
+    using type = decltype(ignore());
+
+    template<class U>
+    static auto tie(U& x) {
+	auto& [m0, m1, m2, m3, m4, m5, m6, m7, m8, m9, m10, m11, m12, m13,
+	       m14, m15, m16, m17, m18, m19, m20, m21, m22, m23, m24, m25,
+	       m26, m27, m28, m29, m30, m31, m32, m33, m34, m35, m36, m37,
+	       m38, m39, m40, m41, m42, m43, m44] = x;
+	return std::tie(m0, m1, m2, m3, m4, m5, m6, m7, m8, m9, m10, m11,
+			m12, m13, m14, m15, m16, m17, m18, m19, m20, m21,
+			m22, m23, m24, m25, m26, m27, m28, m29, m30, m31,
+			m32, m33, m34, m35, m36, m37, m38, m39, m40, m41,
+			m42, m43, m44);
+    }
+};
+
+template<class T>
+struct aggr_field_type_impl<T, 46> {
+    static auto ignore() {
+	T *x = nullptr;
+	auto [m0, m1, m2, m3, m4, m5, m6, m7, m8, m9, m10, m11, m12, m13,
+	      m14, m15, m16, m17, m18, m19, m20, m21, m22, m23, m24, m25,
+	      m26, m27, m28, m29, m30, m31, m32, m33, m34, m35, m36, m37,
+	      m38, m39, m40, m41, m42, m43, m44, m45] = *x;
+	return aggr_field_list<decltype(m0), decltype(m1), decltype(m2),
+			       decltype(m3), decltype(m4), decltype(m5),
+			       decltype(m6), decltype(m7), decltype(m8),
+			       decltype(m9), decltype(m10), decltype(m11),
+			       decltype(m12), decltype(m13), decltype(m14),
+			       decltype(m15), decltype(m16), decltype(m17),
+			       decltype(m18), decltype(m19), decltype(m20),
+			       decltype(m21), decltype(m22), decltype(m23),
+			       decltype(m24), decltype(m25), decltype(m26),
+			       decltype(m27), decltype(m28), decltype(m29),
+			       decltype(m30), decltype(m31), decltype(m32),
+			       decltype(m33), decltype(m34), decltype(m35),
+			       decltype(m36), decltype(m37), decltype(m38),
+			       decltype(m39), decltype(m40), decltype(m41),
+			       decltype(m42), decltype(m43), decltype(m44),
+			       decltype(m45)>{};
+    }
+    using type = decltype(ignore());
+
+    template<class U>
+    static auto tie(U& x) {
+	auto& [m0, m1, m2, m3, m4, m5, m6, m7, m8, m9, m10, m11, m12, m13,
+	       m14, m15, m16, m17, m18, m19, m20, m21, m22, m23, m24, m25,
+	       m26, m27, m28, m29, m30, m31, m32, m33, m34, m35, m36, m37,
+	       m38, m39, m40, m41, m42, m43, m44, m45] = x;
+	return std::tie(m0, m1, m2, m3, m4, m5, m6, m7, m8, m9, m10, m11,
+			m12, m13, m14, m15, m16, m17, m18, m19, m20, m21,
+			m22, m23, m24, m25, m26, m27, m28, m29, m30, m31,
+			m32, m33, m34, m35, m36, m37, m38, m39, m40, m41,
+			m42, m43, m44, m45);
+    }
+};
+
+template<class T>
+struct aggr_field_type_impl<T, 47> {
+    static auto ignore() {
+	T *x = nullptr;
+	auto [m0, m1, m2, m3, m4, m5, m6, m7, m8, m9, m10, m11, m12, m13,
+	      m14, m15, m16, m17, m18, m19, m20, m21, m22, m23, m24, m25,
+	      m26, m27, m28, m29, m30, m31, m32, m33, m34, m35, m36, m37,
+	      m38, m39, m40, m41, m42, m43, m44, m45, m46] = *x;
+	return aggr_field_list<decltype(m0), decltype(m1), decltype(m2),
+			       decltype(m3), decltype(m4), decltype(m5),
+			       decltype(m6), decltype(m7), decltype(m8),
+			       decltype(m9), decltype(m10), decltype(m11),
+			       decltype(m12), decltype(m13), decltype(m14),
+			       decltype(m15), decltype(m16), decltype(m17),
+			       decltype(m18), decltype(m19), decltype(m20),
+			       decltype(m21), decltype(m22), decltype(m23),
+			       decltype(m24), decltype(m25), decltype(m26),
+			       decltype(m27), decltype(m28), decltype(m29),
+			       decltype(m30), decltype(m31), decltype(m32),
+			       decltype(m33), decltype(m34), decltype(m35),
+			       decltype(m36), decltype(m37), decltype(m38),
+			       decltype(m39), decltype(m40), decltype(m41),
+			       decltype(m42), decltype(m43), decltype(m44),
+			       decltype(m45), decltype(m46)>{};
+    }
+    using type = decltype(ignore());
+
+    template<class U>
+    static auto tie(U& x) {
+	auto& [m0, m1, m2, m3, m4, m5, m6, m7, m8, m9, m10, m11, m12, m13,
+	       m14, m15, m16, m17, m18, m19, m20, m21, m22, m23, m24, m25,
+	       m26, m27, m28, m29, m30, m31, m32, m33, m34, m35, m36, m37,
+	       m38, m39, m40, m41, m42, m43, m44, m45, m46] = x;
+	return std::tie(m0, m1, m2, m3, m4, m5, m6, m7, m8, m9, m10, m11,
+			m12, m13, m14, m15, m16, m17, m18, m19, m20, m21,
+			m22, m23, m24, m25, m26, m27, m28, m29, m30, m31,
+			m32, m33, m34, m35, m36, m37, m38, m39, m40, m41,
+			m42, m43, m44, m45, m46);
+    }
+};
+
+template<class T>
+struct aggr_field_type_impl<T, 48> {
+    static auto ignore() {
+	T *x = nullptr;
+	auto [m0, m1, m2, m3, m4, m5, m6, m7, m8, m9, m10, m11, m12, m13,
+	      m14, m15, m16, m17, m18, m19, m20, m21, m22, m23, m24, m25,
+	      m26, m27, m28, m29, m30, m31, m32, m33, m34, m35, m36, m37,
+	      m38, m39, m40, m41, m42, m43, m44, m45, m46, m47] = *x;
+	return aggr_field_list<decltype(m0), decltype(m1), decltype(m2),
+			       decltype(m3), decltype(m4), decltype(m5),
+			       decltype(m6), decltype(m7), decltype(m8),
+			       decltype(m9), decltype(m10), decltype(m11),
+			       decltype(m12), decltype(m13), decltype(m14),
+			       decltype(m15), decltype(m16), decltype(m17),
+			       decltype(m18), decltype(m19), decltype(m20),
+			       decltype(m21), decltype(m22), decltype(m23),
+			       decltype(m24), decltype(m25), decltype(m26),
+			       decltype(m27), decltype(m28), decltype(m29),
+			       decltype(m30), decltype(m31), decltype(m32),
+			       decltype(m33), decltype(m34), decltype(m35),
+			       decltype(m36), decltype(m37), decltype(m38),
+			       decltype(m39), decltype(m40), decltype(m41),
+			       decltype(m42), decltype(m43), decltype(m44),
+			       decltype(m45), decltype(m46), decltype(m47)>{};
+    }
+    using type = decltype(ignore());
+
+    template<class U>
+    static auto tie(U& x) {
+	auto& [m0, m1, m2, m3, m4, m5, m6, m7, m8, m9, m10, m11, m12, m13,
+	       m14, m15, m16, m17, m18, m19, m20, m21, m22, m23, m24, m25,
+	       m26, m27, m28, m29, m30, m31, m32, m33, m34, m35, m36, m37,
+	       m38, m39, m40, m41, m42, m43, m44, m45, m46, m47] = x;
+	return std::tie(m0, m1, m2, m3, m4, m5, m6, m7, m8, m9, m10, m11,
+			m12, m13, m14, m15, m16, m17, m18, m19, m20, m21,
+			m22, m23, m24, m25, m26, m27, m28, m29, m30, m31,
+			m32, m33, m34, m35, m36, m37, m38, m39, m40, m41,
+			m42, m43, m44, m45, m46, m47);
+    }
+};
+
+template<class T>
+struct aggr_field_type_impl<T, 49> {
+    static auto ignore() {
+	T *x = nullptr;
+	auto [m0, m1, m2, m3, m4, m5, m6, m7, m8, m9, m10, m11, m12, m13,
+	      m14, m15, m16, m17, m18, m19, m20, m21, m22, m23, m24, m25,
+	      m26, m27, m28, m29, m30, m31, m32, m33, m34, m35, m36, m37,
+	      m38, m39, m40, m41, m42, m43, m44, m45, m46, m47, m48] = *x;
+	return aggr_field_list<decltype(m0), decltype(m1), decltype(m2),
+			       decltype(m3), decltype(m4), decltype(m5),
+			       decltype(m6), decltype(m7), decltype(m8),
+			       decltype(m9), decltype(m10), decltype(m11),
+			       decltype(m12), decltype(m13), decltype(m14),
+			       decltype(m15), decltype(m16), decltype(m17),
+			       decltype(m18), decltype(m19), decltype(m20),
+			       decltype(m21), decltype(m22), decltype(m23),
+			       decltype(m24), decltype(m25), decltype(m26),
+			       decltype(m27), decltype(m28), decltype(m29),
+			       decltype(m30), decltype(m31), decltype(m32),
+			       decltype(m33), decltype(m34), decltype(m35),
+			       decltype(m36), decltype(m37), decltype(m38),
+			       decltype(m39), decltype(m40), decltype(m41),
+			       decltype(m42), decltype(m43), decltype(m44),
+			       decltype(m45), decltype(m46), decltype(m47),
+			       decltype(m48)>{};
+    }
+    using type = decltype(ignore());
+
+    template<class U>
+    static auto tie(U& x) {
+	auto& [m0, m1, m2, m3, m4, m5, m6, m7, m8, m9, m10, m11, m12, m13,
+	       m14, m15, m16, m17, m18, m19, m20, m21, m22, m23, m24, m25,
+	       m26, m27, m28, m29, m30, m31, m32, m33, m34, m35, m36, m37,
+	       m38, m39, m40, m41, m42, m43, m44, m45, m46, m47, m48] = x;
+	return std::tie(m0, m1, m2, m3, m4, m5, m6, m7, m8, m9, m10, m11,
+			m12, m13, m14, m15, m16, m17, m18, m19, m20, m21,
+			m22, m23, m24, m25, m26, m27, m28, m29, m30, m31,
+			m32, m33, m34, m35, m36, m37, m38, m39, m40, m41,
+			m42, m43, m44, m45, m46, m47, m48);
+    }
+};
+
+template<class T>
+struct aggr_field_type_impl<T, 50> {
+    static auto ignore() {
+	T *x = nullptr;
+	auto [m0, m1, m2, m3, m4, m5, m6, m7, m8, m9, m10, m11, m12, m13,
+	      m14, m15, m16, m17, m18, m19, m20, m21, m22, m23, m24, m25,
+	      m26, m27, m28, m29, m30, m31, m32, m33, m34, m35, m36, m37,
+	      m38, m39, m40, m41, m42, m43, m44, m45, m46, m47, m48, m49] = *x;
+	return aggr_field_list<decltype(m0), decltype(m1), decltype(m2),
+			       decltype(m3), decltype(m4), decltype(m5),
+			       decltype(m6), decltype(m7), decltype(m8),
+			       decltype(m9), decltype(m10), decltype(m11),
+			       decltype(m12), decltype(m13), decltype(m14),
+			       decltype(m15), decltype(m16), decltype(m17),
+			       decltype(m18), decltype(m19), decltype(m20),
+			       decltype(m21), decltype(m22), decltype(m23),
+			       decltype(m24), decltype(m25), decltype(m26),
+			       decltype(m27), decltype(m28), decltype(m29),
+			       decltype(m30), decltype(m31), decltype(m32),
+			       decltype(m33), decltype(m34), decltype(m35),
+			       decltype(m36), decltype(m37), decltype(m38),
+			       decltype(m39), decltype(m40), decltype(m41),
+			       decltype(m42), decltype(m43), decltype(m44),
+			       decltype(m45), decltype(m46), decltype(m47),
+			       decltype(m48), decltype(m49)>{};
+    }
+    using type = decltype(ignore());
+
+    template<class U>
+    static auto tie(U& x) {
+	auto& [m0, m1, m2, m3, m4, m5, m6, m7, m8, m9, m10, m11, m12, m13,
+	       m14, m15, m16, m17, m18, m19, m20, m21, m22, m23, m24, m25,
+	       m26, m27, m28, m29, m30, m31, m32, m33, m34, m35, m36, m37,
+	       m38, m39, m40, m41, m42, m43, m44, m45, m46, m47, m48, m49] = x;
+	return std::tie(m0, m1, m2, m3, m4, m5, m6, m7, m8, m9, m10, m11,
+			m12, m13, m14, m15, m16, m17, m18, m19, m20, m21,
+			m22, m23, m24, m25, m26, m27, m28, m29, m30, m31,
+			m32, m33, m34, m35, m36, m37, m38, m39, m40, m41,
+			m42, m43, m44, m45, m46, m47, m48, m49);
+    }
+};
+
+template<class T>
+struct aggr_field_type_impl<T, 51> {
+    static auto ignore() {
+	T *x = nullptr;
+	auto [m0, m1, m2, m3, m4, m5, m6, m7, m8, m9, m10, m11, m12, m13,
+	      m14, m15, m16, m17, m18, m19, m20, m21, m22, m23, m24, m25,
+	      m26, m27, m28, m29, m30, m31, m32, m33, m34, m35, m36, m37,
+	      m38, m39, m40, m41, m42, m43, m44, m45, m46, m47, m48, m49,
+	      m50] = *x;
+	return aggr_field_list<decltype(m0), decltype(m1), decltype(m2),
+			       decltype(m3), decltype(m4), decltype(m5),
+			       decltype(m6), decltype(m7), decltype(m8),
+			       decltype(m9), decltype(m10), decltype(m11),
+			       decltype(m12), decltype(m13), decltype(m14),
+			       decltype(m15), decltype(m16), decltype(m17),
+			       decltype(m18), decltype(m19), decltype(m20),
+			       decltype(m21), decltype(m22), decltype(m23),
+			       decltype(m24), decltype(m25), decltype(m26),
+			       decltype(m27), decltype(m28), decltype(m29),
+			       decltype(m30), decltype(m31), decltype(m32),
+			       decltype(m33), decltype(m34), decltype(m35),
+			       decltype(m36), decltype(m37), decltype(m38),
+			       decltype(m39), decltype(m40), decltype(m41),
+			       decltype(m42), decltype(m43), decltype(m44),
+			       decltype(m45), decltype(m46), decltype(m47),
+			       decltype(m48), decltype(m49), decltype(m50)>{};
+    }
+    using type = decltype(ignore());
+
+    template<class U>
+    static auto tie(U& x) {
+	auto& [m0, m1, m2, m3, m4, m5, m6, m7, m8, m9, m10, m11, m12, m13,
+	       m14, m15, m16, m17, m18, m19, m20, m21, m22, m23, m24, m25,
+	       m26, m27, m28, m29, m30, m31, m32, m33, m34, m35, m36, m37,
+	       m38, m39, m40, m41, m42, m43, m44, m45, m46, m47, m48, m49,
+	       m50] = x;
+	return std::tie(m0, m1, m2, m3, m4, m5, m6, m7, m8, m9, m10, m11,
+			m12, m13, m14, m15, m16, m17, m18, m19, m20, m21,
+			m22, m23, m24, m25, m26, m27, m28, m29, m30, m31,
+			m32, m33, m34, m35, m36, m37, m38, m39, m40, m41,
+			m42, m43, m44, m45, m46, m47, m48, m49, m50);
+    }
+};
+
+template<class T>
+struct aggr_field_type_impl<T, 52> {
+    static auto ignore() {
+	T *x = nullptr;
+	auto [m0, m1, m2, m3, m4, m5, m6, m7, m8, m9, m10, m11, m12, m13,
+	      m14, m15, m16, m17, m18, m19, m20, m21, m22, m23, m24, m25,
+	      m26, m27, m28, m29, m30, m31, m32, m33, m34, m35, m36, m37,
+	      m38, m39, m40, m41, m42, m43, m44, m45, m46, m47, m48, m49,
+	      m50, m51] = *x;
+	return aggr_field_list<decltype(m0), decltype(m1), decltype(m2),
+			       decltype(m3), decltype(m4), decltype(m5),
+			       decltype(m6), decltype(m7), decltype(m8),
+			       decltype(m9), decltype(m10), decltype(m11),
+			       decltype(m12), decltype(m13), decltype(m14),
+			       decltype(m15), decltype(m16), decltype(m17),
+			       decltype(m18), decltype(m19), decltype(m20),
+			       decltype(m21), decltype(m22), decltype(m23),
+			       decltype(m24), decltype(m25), decltype(m26),
+			       decltype(m27), decltype(m28), decltype(m29),
+			       decltype(m30), decltype(m31), decltype(m32),
+			       decltype(m33), decltype(m34), decltype(m35),
+			       decltype(m36), decltype(m37), decltype(m38),
+			       decltype(m39), decltype(m40), decltype(m41),
+			       decltype(m42), decltype(m43), decltype(m44),
+			       decltype(m45), decltype(m46), decltype(m47),
+			       decltype(m48), decltype(m49), decltype(m50),
+			       decltype(m51)>{};
+    }
+    using type = decltype(ignore());
+
+    template<class U>
+    static auto tie(U& x) {
+	auto& [m0, m1, m2, m3, m4, m5, m6, m7, m8, m9, m10, m11, m12, m13,
+	       m14, m15, m16, m17, m18, m19, m20, m21, m22, m23, m24, m25,
+	       m26, m27, m28, m29, m30, m31, m32, m33, m34, m35, m36, m37,
+	       m38, m39, m40, m41, m42, m43, m44, m45, m46, m47, m48, m49,
+	       m50, m51] = x;
+	return std::tie(m0, m1, m2, m3, m4, m5, m6, m7, m8, m9, m10, m11,
+			m12, m13, m14, m15, m16, m17, m18, m19, m20, m21,
+			m22, m23, m24, m25, m26, m27, m28, m29, m30, m31,
+			m32, m33, m34, m35, m36, m37, m38, m39, m40, m41,
+			m42, m43, m44, m45, m46, m47, m48, m49, m50, m51);
+    }
+};
+
+template<class T>
+struct aggr_field_type_impl<T, 53> {
+    static auto ignore() {
+	T *x = nullptr;
+	auto [m0, m1, m2, m3, m4, m5, m6, m7, m8, m9, m10, m11, m12, m13,
+	      m14, m15, m16, m17, m18, m19, m20, m21, m22, m23, m24, m25,
+	      m26, m27, m28, m29, m30, m31, m32, m33, m34, m35, m36, m37,
+	      m38, m39, m40, m41, m42, m43, m44, m45, m46, m47, m48, m49,
+	      m50, m51, m52] = *x;
+	return aggr_field_list<decltype(m0), decltype(m1), decltype(m2),
+			       decltype(m3), decltype(m4), decltype(m5),
+			       decltype(m6), decltype(m7), decltype(m8),
+			       decltype(m9), decltype(m10), decltype(m11),
+			       decltype(m12), decltype(m13), decltype(m14),
+			       decltype(m15), decltype(m16), decltype(m17),
+			       decltype(m18), decltype(m19), decltype(m20),
+			       decltype(m21), decltype(m22), decltype(m23),
+			       decltype(m24), decltype(m25), decltype(m26),
+			       decltype(m27), decltype(m28), decltype(m29),
+			       decltype(m30), decltype(m31), decltype(m32),
+			       decltype(m33), decltype(m34), decltype(m35),
+			       decltype(m36), decltype(m37), decltype(m38),
+			       decltype(m39), decltype(m40), decltype(m41),
+			       decltype(m42), decltype(m43), decltype(m44),
+			       decltype(m45), decltype(m46), decltype(m47),
+			       decltype(m48), decltype(m49), decltype(m50),
+			       decltype(m51), decltype(m52)>{};
+    }
+    using type = decltype(ignore());
+
+    template<class U>
+    static auto tie(U& x) {
+	auto& [m0, m1, m2, m3, m4, m5, m6, m7, m8, m9, m10, m11, m12, m13,
+	       m14, m15, m16, m17, m18, m19, m20, m21, m22, m23, m24, m25,
+	       m26, m27, m28, m29, m30, m31, m32, m33, m34, m35, m36, m37,
+	       m38, m39, m40, m41, m42, m43, m44, m45, m46, m47, m48, m49,
+	       m50, m51, m52] = x;
+	return std::tie(m0, m1, m2, m3, m4, m5, m6, m7, m8, m9, m10, m11,
+			m12, m13, m14, m15, m16, m17, m18, m19, m20, m21,
+			m22, m23, m24, m25, m26, m27, m28, m29, m30, m31,
+			m32, m33, m34, m35, m36, m37, m38, m39, m40, m41,
+			m42, m43, m44, m45, m46, m47, m48, m49, m50, m51,
+			m52);
+    }
+};
+
+template<class T>
+struct aggr_field_type_impl<T, 54> {
+    static auto ignore() {
+	T *x = nullptr;
+	auto [m0, m1, m2, m3, m4, m5, m6, m7, m8, m9, m10, m11, m12, m13,
+	      m14, m15, m16, m17, m18, m19, m20, m21, m22, m23, m24, m25,
+	      m26, m27, m28, m29, m30, m31, m32, m33, m34, m35, m36, m37,
+	      m38, m39, m40, m41, m42, m43, m44, m45, m46, m47, m48, m49,
+	      m50, m51, m52, m53] = *x;
+	return aggr_field_list<decltype(m0), decltype(m1), decltype(m2),
+			       decltype(m3), decltype(m4), decltype(m5),
+			       decltype(m6), decltype(m7), decltype(m8),
+			       decltype(m9), decltype(m10), decltype(m11),
+			       decltype(m12), decltype(m13), decltype(m14),
+			       decltype(m15), decltype(m16), decltype(m17),
+			       decltype(m18), decltype(m19), decltype(m20),
+			       decltype(m21), decltype(m22), decltype(m23),
+			       decltype(m24), decltype(m25), decltype(m26),
+			       decltype(m27), decltype(m28), decltype(m29),
+			       decltype(m30), decltype(m31), decltype(m32),
+			       decltype(m33), decltype(m34), decltype(m35),
+			       decltype(m36), decltype(m37), decltype(m38),
+			       decltype(m39), decltype(m40), decltype(m41),
+			       decltype(m42), decltype(m43), decltype(m44),
+			       decltype(m45), decltype(m46), decltype(m47),
+			       decltype(m48), decltype(m49), decltype(m50),
+			       decltype(m51), decltype(m52), decltype(m53)>{};
+    }
+    using type = decltype(ignore());
+
+    template<class U>
+    static auto tie(U& x) {
+	auto& [m0, m1, m2, m3, m4, m5, m6, m7, m8, m9, m10, m11, m12, m13,
+	       m14, m15, m16, m17, m18, m19, m20, m21, m22, m23, m24, m25,
+	       m26, m27, m28, m29, m30, m31, m32, m33, m34, m35, m36, m37,
+	       m38, m39, m40, m41, m42, m43, m44, m45, m46, m47, m48, m49,
+	       m50, m51, m52, m53] = x;
+	return std::tie(m0, m1, m2, m3, m4, m5, m6, m7, m8, m9, m10, m11,
+			m12, m13, m14, m15, m16, m17, m18, m19, m20, m21,
+			m22, m23, m24, m25, m26, m27, m28, m29, m30, m31,
+			m32, m33, m34, m35, m36, m37, m38, m39, m40, m41,
+			m42, m43, m44, m45, m46, m47, m48, m49, m50, m51,
+			m52, m53);
+    }
+};
+
+template<class T>
+struct aggr_field_type_impl<T, 55> {
+    static auto ignore() {
+	T *x = nullptr;
+	auto [m0, m1, m2, m3, m4, m5, m6, m7, m8, m9, m10, m11, m12, m13,
+	      m14, m15, m16, m17, m18, m19, m20, m21, m22, m23, m24, m25,
+	      m26, m27, m28, m29, m30, m31, m32, m33, m34, m35, m36, m37,
+	      m38, m39, m40, m41, m42, m43, m44, m45, m46, m47, m48, m49,
+	      m50, m51, m52, m53, m54] = *x;
+	return aggr_field_list<decltype(m0), decltype(m1), decltype(m2),
+			       decltype(m3), decltype(m4), decltype(m5),
+			       decltype(m6), decltype(m7), decltype(m8),
+			       decltype(m9), decltype(m10), decltype(m11),
+			       decltype(m12), decltype(m13), decltype(m14),
+			       decltype(m15), decltype(m16), decltype(m17),
+			       decltype(m18), decltype(m19), decltype(m20),
+			       decltype(m21), decltype(m22), decltype(m23),
+			       decltype(m24), decltype(m25), decltype(m26),
+			       decltype(m27), decltype(m28), decltype(m29),
+			       decltype(m30), decltype(m31), decltype(m32),
+			       decltype(m33), decltype(m34), decltype(m35),
+			       decltype(m36), decltype(m37), decltype(m38),
+			       decltype(m39), decltype(m40), decltype(m41),
+			       decltype(m42), decltype(m43), decltype(m44),
+			       decltype(m45), decltype(m46), decltype(m47),
+			       decltype(m48), decltype(m49), decltype(m50),
+			       decltype(m51), decltype(m52), decltype(m53),
+			       decltype(m54)>{};
+    }
+    using type = decltype(ignore());
+
+    template<class U>
+    static auto tie(U& x) {
+	auto& [m0, m1, m2, m3, m4, m5, m6, m7, m8, m9, m10, m11, m12, m13,
+	       m14, m15, m16, m17, m18, m19, m20, m21, m22, m23, m24, m25,
+	       m26, m27, m28, m29, m30, m31, m32, m33, m34, m35, m36, m37,
+	       m38, m39, m40, m41, m42, m43, m44, m45, m46, m47, m48, m49,
+	       m50, m51, m52, m53, m54] = x;
+	return std::tie(m0, m1, m2, m3, m4, m5, m6, m7, m8, m9, m10, m11,
+			m12, m13, m14, m15, m16, m17, m18, m19, m20, m21,
+			m22, m23, m24, m25, m26, m27, m28, m29, m30, m31,
+			m32, m33, m34, m35, m36, m37, m38, m39, m40, m41,
+			m42, m43, m44, m45, m46, m47, m48, m49, m50, m51,
+			m52, m53, m54);
+    }
+};
+
+template<class T>
+struct aggr_field_type_impl<T, 56> {
+    static auto ignore() {
+	T *x = nullptr;
+	auto [m0, m1, m2, m3, m4, m5, m6, m7, m8, m9, m10, m11, m12, m13,
+	      m14, m15, m16, m17, m18, m19, m20, m21, m22, m23, m24, m25,
+	      m26, m27, m28, m29, m30, m31, m32, m33, m34, m35, m36, m37,
+	      m38, m39, m40, m41, m42, m43, m44, m45, m46, m47, m48, m49,
+	      m50, m51, m52, m53, m54, m55] = *x;
+	return aggr_field_list<decltype(m0), decltype(m1), decltype(m2),
+			       decltype(m3), decltype(m4), decltype(m5),
+			       decltype(m6), decltype(m7), decltype(m8),
+			       decltype(m9), decltype(m10), decltype(m11),
+			       decltype(m12), decltype(m13), decltype(m14),
+			       decltype(m15), decltype(m16), decltype(m17),
+			       decltype(m18), decltype(m19), decltype(m20),
+			       decltype(m21), decltype(m22), decltype(m23),
+			       decltype(m24), decltype(m25), decltype(m26),
+			       decltype(m27), decltype(m28), decltype(m29),
+			       decltype(m30), decltype(m31), decltype(m32),
+			       decltype(m33), decltype(m34), decltype(m35),
+			       decltype(m36), decltype(m37), decltype(m38),
+			       decltype(m39), decltype(m40), decltype(m41),
+			       decltype(m42), decltype(m43), decltype(m44),
+			       decltype(m45), decltype(m46), decltype(m47),
+			       decltype(m48), decltype(m49), decltype(m50),
+			       decltype(m51), decltype(m52), decltype(m53),
+			       decltype(m54), decltype(m55)>{};
+    }
+    using type = decltype(ignore());
+
+    template<class U>
+    static auto tie(U& x) {
+	auto& [m0, m1, m2, m3, m4, m5, m6, m7, m8, m9, m10, m11, m12, m13,
+	       m14, m15, m16, m17, m18, m19, m20, m21, m22, m23, m24, m25,
+	       m26, m27, m28, m29, m30, m31, m32, m33, m34, m35, m36, m37,
+	       m38, m39, m40, m41, m42, m43, m44, m45, m46, m47, m48, m49,
+	       m50, m51, m52, m53, m54, m55] = x;
+	return std::tie(m0, m1, m2, m3, m4, m5, m6, m7, m8, m9, m10, m11,
+			m12, m13, m14, m15, m16, m17, m18, m19, m20, m21,
+			m22, m23, m24, m25, m26, m27, m28, m29, m30, m31,
+			m32, m33, m34, m35, m36, m37, m38, m39, m40, m41,
+			m42, m43, m44, m45, m46, m47, m48, m49, m50, m51,
+			m52, m53, m54, m55);
+    }
+};
+
+template<class T>
+struct aggr_field_type_impl<T, 57> {
+    static auto ignore() {
+	T *x = nullptr;
+	auto [m0, m1, m2, m3, m4, m5, m6, m7, m8, m9, m10, m11, m12, m13,
+	      m14, m15, m16, m17, m18, m19, m20, m21, m22, m23, m24, m25,
+	      m26, m27, m28, m29, m30, m31, m32, m33, m34, m35, m36, m37,
+	      m38, m39, m40, m41, m42, m43, m44, m45, m46, m47, m48, m49,
+	      m50, m51, m52, m53, m54, m55, m56] = *x;
+	return aggr_field_list<decltype(m0), decltype(m1), decltype(m2),
+			       decltype(m3), decltype(m4), decltype(m5),
+			       decltype(m6), decltype(m7), decltype(m8),
+			       decltype(m9), decltype(m10), decltype(m11),
+			       decltype(m12), decltype(m13), decltype(m14),
+			       decltype(m15), decltype(m16), decltype(m17),
+			       decltype(m18), decltype(m19), decltype(m20),
+			       decltype(m21), decltype(m22), decltype(m23),
+			       decltype(m24), decltype(m25), decltype(m26),
+			       decltype(m27), decltype(m28), decltype(m29),
+			       decltype(m30), decltype(m31), decltype(m32),
+			       decltype(m33), decltype(m34), decltype(m35),
+			       decltype(m36), decltype(m37), decltype(m38),
+			       decltype(m39), decltype(m40), decltype(m41),
+			       decltype(m42), decltype(m43), decltype(m44),
+			       decltype(m45), decltype(m46), decltype(m47),
+			       decltype(m48), decltype(m49), decltype(m50),
+			       decltype(m51), decltype(m52), decltype(m53),
+			       decltype(m54), decltype(m55), decltype(m56)>{};
+    }
+    using type = decltype(ignore());
+
+    template<class U>
+    static auto tie(U& x) {
+	auto& [m0, m1, m2, m3, m4, m5, m6, m7, m8, m9, m10, m11, m12, m13,
+	       m14, m15, m16, m17, m18, m19, m20, m21, m22, m23, m24, m25,
+	       m26, m27, m28, m29, m30, m31, m32, m33, m34, m35, m36, m37,
+	       m38, m39, m40, m41, m42, m43, m44, m45, m46, m47, m48, m49,
+	       m50, m51, m52, m53, m54, m55, m56] = x;
+	return std::tie(m0, m1, m2, m3, m4, m5, m6, m7, m8, m9, m10, m11,
+			m12, m13, m14, m15, m16, m17, m18, m19, m20, m21,
+			m22, m23, m24, m25, m26, m27, m28, m29, m30, m31,
+			m32, m33, m34, m35, m36, m37, m38, m39, m40, m41,
+			m42, m43, m44, m45, m46, m47, m48, m49, m50, m51,
+			m52, m53, m54, m55, m56);
+    }
+};
+
+template<class T>
+struct aggr_field_type_impl<T, 58> {
+    static auto ignore() {
+	T *x = nullptr;
+	auto [m0, m1, m2, m3, m4, m5, m6, m7, m8, m9, m10, m11, m12, m13,
+	      m14, m15, m16, m17, m18, m19, m20, m21, m22, m23, m24, m25,
+	      m26, m27, m28, m29, m30, m31, m32, m33, m34, m35, m36, m37,
+	      m38, m39, m40, m41, m42, m43, m44, m45, m46, m47, m48, m49,
+	      m50, m51, m52, m53, m54, m55, m56, m57] = *x;
+	return aggr_field_list<decltype(m0), decltype(m1), decltype(m2),
+			       decltype(m3), decltype(m4), decltype(m5),
+			       decltype(m6), decltype(m7), decltype(m8),
+			       decltype(m9), decltype(m10), decltype(m11),
+			       decltype(m12), decltype(m13), decltype(m14),
+			       decltype(m15), decltype(m16), decltype(m17),
+			       decltype(m18), decltype(m19), decltype(m20),
+			       decltype(m21), decltype(m22), decltype(m23),
+			       decltype(m24), decltype(m25), decltype(m26),
+			       decltype(m27), decltype(m28), decltype(m29),
+			       decltype(m30), decltype(m31), decltype(m32),
+			       decltype(m33), decltype(m34), decltype(m35),
+			       decltype(m36), decltype(m37), decltype(m38),
+			       decltype(m39), decltype(m40), decltype(m41),
+			       decltype(m42), decltype(m43), decltype(m44),
+			       decltype(m45), decltype(m46), decltype(m47),
+			       decltype(m48), decltype(m49), decltype(m50),
+			       decltype(m51), decltype(m52), decltype(m53),
+			       decltype(m54), decltype(m55), decltype(m56),
+			       decltype(m57)>{};
+    }
+    using type = decltype(ignore());
+
+    template<class U>
+    static auto tie(U& x) {
+	auto& [m0, m1, m2, m3, m4, m5, m6, m7, m8, m9, m10, m11, m12, m13,
+	       m14, m15, m16, m17, m18, m19, m20, m21, m22, m23, m24, m25,
+	       m26, m27, m28, m29, m30, m31, m32, m33, m34, m35, m36, m37,
+	       m38, m39, m40, m41, m42, m43, m44, m45, m46, m47, m48, m49,
+	       m50, m51, m52, m53, m54, m55, m56, m57] = x;
+	return std::tie(m0, m1, m2, m3, m4, m5, m6, m7, m8, m9, m10, m11,
+			m12, m13, m14, m15, m16, m17, m18, m19, m20, m21,
+			m22, m23, m24, m25, m26, m27, m28, m29, m30, m31,
+			m32, m33, m34, m35, m36, m37, m38, m39, m40, m41,
+			m42, m43, m44, m45, m46, m47, m48, m49, m50, m51,
+			m52, m53, m54, m55, m56, m57);
+    }
+};
+
+template<class T>
+struct aggr_field_type_impl<T, 59> {
+    static auto ignore() {
+	T *x = nullptr;
+	auto [m0, m1, m2, m3, m4, m5, m6, m7, m8, m9, m10, m11, m12, m13,
+	      m14, m15, m16, m17, m18, m19, m20, m21, m22, m23, m24, m25,
+	      m26, m27, m28, m29, m30, m31, m32, m33, m34, m35, m36, m37,
+	      m38, m39, m40, m41, m42, m43, m44, m45, m46, m47, m48, m49,
+	      m50, m51, m52, m53, m54, m55, m56, m57, m58] = *x;
+	return aggr_field_list<decltype(m0), decltype(m1), decltype(m2),
+			       decltype(m3), decltype(m4), decltype(m5),
+			       decltype(m6), decltype(m7), decltype(m8),
+			       decltype(m9), decltype(m10), decltype(m11),
+			       decltype(m12), decltype(m13), decltype(m14),
+			       decltype(m15), decltype(m16), decltype(m17),
+			       decltype(m18), decltype(m19), decltype(m20),
+			       decltype(m21), decltype(m22), decltype(m23),
+			       decltype(m24), decltype(m25), decltype(m26),
+			       decltype(m27), decltype(m28), decltype(m29),
+			       decltype(m30), decltype(m31), decltype(m32),
+			       decltype(m33), decltype(m34), decltype(m35),
+			       decltype(m36), decltype(m37), decltype(m38),
+			       decltype(m39), decltype(m40), decltype(m41),
+			       decltype(m42), decltype(m43), decltype(m44),
+			       decltype(m45), decltype(m46), decltype(m47),
+			       decltype(m48), decltype(m49), decltype(m50),
+			       decltype(m51), decltype(m52), decltype(m53),
+			       decltype(m54), decltype(m55), decltype(m56),
+			       decltype(m57), decltype(m58)>{};
+    }
+    using type = decltype(ignore());
+
+    template<class U>
+    static auto tie(U& x) {
+	auto& [m0, m1, m2, m3, m4, m5, m6, m7, m8, m9, m10, m11, m12, m13,
+	       m14, m15, m16, m17, m18, m19, m20, m21, m22, m23, m24, m25,
+	       m26, m27, m28, m29, m30, m31, m32, m33, m34, m35, m36, m37,
+	       m38, m39, m40, m41, m42, m43, m44, m45, m46, m47, m48, m49,
+	       m50, m51, m52, m53, m54, m55, m56, m57, m58] = x;
+	return std::tie(m0, m1, m2, m3, m4, m5, m6, m7, m8, m9, m10, m11,
+			m12, m13, m14, m15, m16, m17, m18, m19, m20, m21,
+			m22, m23, m24, m25, m26, m27, m28, m29, m30, m31,
+			m32, m33, m34, m35, m36, m37, m38, m39, m40, m41,
+			m42, m43, m44, m45, m46, m47, m48, m49, m50, m51,
+			m52, m53, m54, m55, m56, m57, m58);
+    }
+};
+
+template<class T>
+struct aggr_field_type_impl<T, 60> {
+    static auto ignore() {
+	T *x = nullptr;
+	auto [m0, m1, m2, m3, m4, m5, m6, m7, m8, m9, m10, m11, m12, m13,
+	      m14, m15, m16, m17, m18, m19, m20, m21, m22, m23, m24, m25,
+	      m26, m27, m28, m29, m30, m31, m32, m33, m34, m35, m36, m37,
+	      m38, m39, m40, m41, m42, m43, m44, m45, m46, m47, m48, m49,
+	      m50, m51, m52, m53, m54, m55, m56, m57, m58, m59] = *x;
+	return aggr_field_list<decltype(m0), decltype(m1), decltype(m2),
+			       decltype(m3), decltype(m4), decltype(m5),
+			       decltype(m6), decltype(m7), decltype(m8),
+			       decltype(m9), decltype(m10), decltype(m11),
+			       decltype(m12), decltype(m13), decltype(m14),
+			       decltype(m15), decltype(m16), decltype(m17),
+			       decltype(m18), decltype(m19), decltype(m20),
+			       decltype(m21), decltype(m22), decltype(m23),
+			       decltype(m24), decltype(m25), decltype(m26),
+			       decltype(m27), decltype(m28), decltype(m29),
+			       decltype(m30), decltype(m31), decltype(m32),
+			       decltype(m33), decltype(m34), decltype(m35),
+			       decltype(m36), decltype(m37), decltype(m38),
+			       decltype(m39), decltype(m40), decltype(m41),
+			       decltype(m42), decltype(m43), decltype(m44),
+			       decltype(m45), decltype(m46), decltype(m47),
+			       decltype(m48), decltype(m49), decltype(m50),
+			       decltype(m51), decltype(m52), decltype(m53),
+			       decltype(m54), decltype(m55), decltype(m56),
+			       decltype(m57), decltype(m58), decltype(m59)>{};
+    }
+    using type = decltype(ignore());
+
+    template<class U>
+    static auto tie(U& x) {
+	auto& [m0, m1, m2, m3, m4, m5, m6, m7, m8, m9, m10, m11, m12, m13,
+	       m14, m15, m16, m17, m18, m19, m20, m21, m22, m23, m24, m25,
+	       m26, m27, m28, m29, m30, m31, m32, m33, m34, m35, m36, m37,
+	       m38, m39, m40, m41, m42, m43, m44, m45, m46, m47, m48, m49,
+	       m50, m51, m52, m53, m54, m55, m56, m57, m58, m59] = x;
+	return std::tie(m0, m1, m2, m3, m4, m5, m6, m7, m8, m9, m10, m11,
+			m12, m13, m14, m15, m16, m17, m18, m19, m20, m21,
+			m22, m23, m24, m25, m26, m27, m28, m29, m30, m31,
+			m32, m33, m34, m35, m36, m37, m38, m39, m40, m41,
+			m42, m43, m44, m45, m46, m47, m48, m49, m50, m51,
+			m52, m53, m54, m55, m56, m57, m58, m59);
+    }
+};
+
+template<class T>
+struct aggr_field_type_impl<T, 61> {
+    static auto ignore() {
+	T *x = nullptr;
+	auto [m0, m1, m2, m3, m4, m5, m6, m7, m8, m9, m10, m11, m12, m13,
+	      m14, m15, m16, m17, m18, m19, m20, m21, m22, m23, m24, m25,
+	      m26, m27, m28, m29, m30, m31, m32, m33, m34, m35, m36, m37,
+	      m38, m39, m40, m41, m42, m43, m44, m45, m46, m47, m48, m49,
+	      m50, m51, m52, m53, m54, m55, m56, m57, m58, m59, m60] = *x;
+	return aggr_field_list<decltype(m0), decltype(m1), decltype(m2),
+			       decltype(m3), decltype(m4), decltype(m5),
+			       decltype(m6), decltype(m7), decltype(m8),
+			       decltype(m9), decltype(m10), decltype(m11),
+			       decltype(m12), decltype(m13), decltype(m14),
+			       decltype(m15), decltype(m16), decltype(m17),
+			       decltype(m18), decltype(m19), decltype(m20),
+			       decltype(m21), decltype(m22), decltype(m23),
+			       decltype(m24), decltype(m25), decltype(m26),
+			       decltype(m27), decltype(m28), decltype(m29),
+			       decltype(m30), decltype(m31), decltype(m32),
+			       decltype(m33), decltype(m34), decltype(m35),
+			       decltype(m36), decltype(m37), decltype(m38),
+			       decltype(m39), decltype(m40), decltype(m41),
+			       decltype(m42), decltype(m43), decltype(m44),
+			       decltype(m45), decltype(m46), decltype(m47),
+			       decltype(m48), decltype(m49), decltype(m50),
+			       decltype(m51), decltype(m52), decltype(m53),
+			       decltype(m54), decltype(m55), decltype(m56),
+			       decltype(m57), decltype(m58), decltype(m59),
+			       decltype(m60)>{};
+    }
+    using type = decltype(ignore());
+
+    template<class U>
+    static auto tie(U& x) {
+	auto& [m0, m1, m2, m3, m4, m5, m6, m7, m8, m9, m10, m11, m12, m13,
+	       m14, m15, m16, m17, m18, m19, m20, m21, m22, m23, m24, m25,
+	       m26, m27, m28, m29, m30, m31, m32, m33, m34, m35, m36, m37,
+	       m38, m39, m40, m41, m42, m43, m44, m45, m46, m47, m48, m49,
+	       m50, m51, m52, m53, m54, m55, m56, m57, m58, m59, m60] = x;
+	return std::tie(m0, m1, m2, m3, m4, m5, m6, m7, m8, m9, m10, m11,
+			m12, m13, m14, m15, m16, m17, m18, m19, m20, m21,
+			m22, m23, m24, m25, m26, m27, m28, m29, m30, m31,
+			m32, m33, m34, m35, m36, m37, m38, m39, m40, m41,
+			m42, m43, m44, m45, m46, m47, m48, m49, m50, m51,
+			m52, m53, m54, m55, m56, m57, m58, m59, m60);
+    }
+};
+
+template<class T>
+struct aggr_field_type_impl<T, 62> {
+    static auto ignore() {
+	T *x = nullptr;
+	auto [m0, m1, m2, m3, m4, m5, m6, m7, m8, m9, m10, m11, m12, m13,
+	      m14, m15, m16, m17, m18, m19, m20, m21, m22, m23, m24, m25,
+	      m26, m27, m28, m29, m30, m31, m32, m33, m34, m35, m36, m37,
+	      m38, m39, m40, m41, m42, m43, m44, m45, m46, m47, m48, m49,
+	      m50, m51, m52, m53, m54, m55, m56, m57, m58, m59, m60, m61] = *x;
+	return aggr_field_list<decltype(m0), decltype(m1), decltype(m2),
+			       decltype(m3), decltype(m4), decltype(m5),
+			       decltype(m6), decltype(m7), decltype(m8),
+			       decltype(m9), decltype(m10), decltype(m11),
+			       decltype(m12), decltype(m13), decltype(m14),
+			       decltype(m15), decltype(m16), decltype(m17),
+			       decltype(m18), decltype(m19), decltype(m20),
+			       decltype(m21), decltype(m22), decltype(m23),
+			       decltype(m24), decltype(m25), decltype(m26),
+			       decltype(m27), decltype(m28), decltype(m29),
+			       decltype(m30), decltype(m31), decltype(m32),
+			       decltype(m33), decltype(m34), decltype(m35),
+			       decltype(m36), decltype(m37), decltype(m38),
+			       decltype(m39), decltype(m40), decltype(m41),
+			       decltype(m42), decltype(m43), decltype(m44),
+			       decltype(m45), decltype(m46), decltype(m47),
+			       decltype(m48), decltype(m49), decltype(m50),
+			       decltype(m51), decltype(m52), decltype(m53),
+			       decltype(m54), decltype(m55), decltype(m56),
+			       decltype(m57), decltype(m58), decltype(m59),
+			       decltype(m60), decltype(m61)>{};
+    }
+    using type = decltype(ignore());
+
+    template<class U>
+    static auto tie(U& x) {
+	auto& [m0, m1, m2, m3, m4, m5, m6, m7, m8, m9, m10, m11, m12, m13,
+	       m14, m15, m16, m17, m18, m19, m20, m21, m22, m23, m24, m25,
+	       m26, m27, m28, m29, m30, m31, m32, m33, m34, m35, m36, m37,
+	       m38, m39, m40, m41, m42, m43, m44, m45, m46, m47, m48, m49,
+	       m50, m51, m52, m53, m54, m55, m56, m57, m58, m59, m60, m61] = x;
+	return std::tie(m0, m1, m2, m3, m4, m5, m6, m7, m8, m9, m10, m11,
+			m12, m13, m14, m15, m16, m17, m18, m19, m20, m21,
+			m22, m23, m24, m25, m26, m27, m28, m29, m30, m31,
+			m32, m33, m34, m35, m36, m37, m38, m39, m40, m41,
+			m42, m43, m44, m45, m46, m47, m48, m49, m50, m51,
+			m52, m53, m54, m55, m56, m57, m58, m59, m60, m61);
+    }
+};
+
+template<class T>
+struct aggr_field_type_impl<T, 63> {
+    static auto ignore() {
+	T *x = nullptr;
+	auto [m0, m1, m2, m3, m4, m5, m6, m7, m8, m9, m10, m11, m12, m13,
+	      m14, m15, m16, m17, m18, m19, m20, m21, m22, m23, m24, m25,
+	      m26, m27, m28, m29, m30, m31, m32, m33, m34, m35, m36, m37,
+	      m38, m39, m40, m41, m42, m43, m44, m45, m46, m47, m48, m49,
+	      m50, m51, m52, m53, m54, m55, m56, m57, m58, m59, m60, m61,
+	      m62] = *x;
+	return aggr_field_list<decltype(m0), decltype(m1), decltype(m2),
+			       decltype(m3), decltype(m4), decltype(m5),
+			       decltype(m6), decltype(m7), decltype(m8),
+			       decltype(m9), decltype(m10), decltype(m11),
+			       decltype(m12), decltype(m13), decltype(m14),
+			       decltype(m15), decltype(m16), decltype(m17),
+			       decltype(m18), decltype(m19), decltype(m20),
+			       decltype(m21), decltype(m22), decltype(m23),
+			       decltype(m24), decltype(m25), decltype(m26),
+			       decltype(m27), decltype(m28), decltype(m29),
+			       decltype(m30), decltype(m31), decltype(m32),
+			       decltype(m33), decltype(m34), decltype(m35),
+			       decltype(m36), decltype(m37), decltype(m38),
+			       decltype(m39), decltype(m40), decltype(m41),
+			       decltype(m42), decltype(m43), decltype(m44),
+			       decltype(m45), decltype(m46), decltype(m47),
+			       decltype(m48), decltype(m49), decltype(m50),
+			       decltype(m51), decltype(m52), decltype(m53),
+			       decltype(m54), decltype(m55), decltype(m56),
+			       decltype(m57), decltype(m58), decltype(m59),
+			       decltype(m60), decltype(m61), decltype(m62)>{};
+    }
+    using type = decltype(ignore());
+
+    template<class U>
+    static auto tie(U& x) {
+	auto& [m0, m1, m2, m3, m4, m5, m6, m7, m8, m9, m10, m11, m12, m13,
+	       m14, m15, m16, m17, m18, m19, m20, m21, m22, m23, m24, m25,
+	       m26, m27, m28, m29, m30, m31, m32, m33, m34, m35, m36, m37,
+	       m38, m39, m40, m41, m42, m43, m44, m45, m46, m47, m48, m49,
+	       m50, m51, m52, m53, m54, m55, m56, m57, m58, m59, m60, m61,
+	       m62] = x;
+	return std::tie(m0, m1, m2, m3, m4, m5, m6, m7, m8, m9, m10, m11,
+			m12, m13, m14, m15, m16, m17, m18, m19, m20, m21,
+			m22, m23, m24, m25, m26, m27, m28, m29, m30, m31,
+			m32, m33, m34, m35, m36, m37, m38, m39, m40, m41,
+			m42, m43, m44, m45, m46, m47, m48, m49, m50, m51,
+			m52, m53, m54, m55, m56, m57, m58, m59, m60, m61,
+			m62);
+    }
+};
+
+template<class T>
+struct aggr_field_type_impl<T, 64> {
+    static auto ignore() {
+	T *x = nullptr;
+	auto [m0, m1, m2, m3, m4, m5, m6, m7, m8, m9, m10, m11, m12, m13,
+	      m14, m15, m16, m17, m18, m19, m20, m21, m22, m23, m24, m25,
+	      m26, m27, m28, m29, m30, m31, m32, m33, m34, m35, m36, m37,
+	      m38, m39, m40, m41, m42, m43, m44, m45, m46, m47, m48, m49,
+	      m50, m51, m52, m53, m54, m55, m56, m57, m58, m59, m60, m61,
+	      m62, m63] = *x;
+	return aggr_field_list<decltype(m0), decltype(m1), decltype(m2),
+			       decltype(m3), decltype(m4), decltype(m5),
+			       decltype(m6), decltype(m7), decltype(m8),
+			       decltype(m9), decltype(m10), decltype(m11),
+			       decltype(m12), decltype(m13), decltype(m14),
+			       decltype(m15), decltype(m16), decltype(m17),
+			       decltype(m18), decltype(m19), decltype(m20),
+			       decltype(m21), decltype(m22), decltype(m23),
+			       decltype(m24), decltype(m25), decltype(m26),
+			       decltype(m27), decltype(m28), decltype(m29),
+			       decltype(m30), decltype(m31), decltype(m32),
+			       decltype(m33), decltype(m34), decltype(m35),
+			       decltype(m36), decltype(m37), decltype(m38),
+			       decltype(m39), decltype(m40), decltype(m41),
+			       decltype(m42), decltype(m43), decltype(m44),
+			       decltype(m45), decltype(m46), decltype(m47),
+			       decltype(m48), decltype(m49), decltype(m50),
+			       decltype(m51), decltype(m52), decltype(m53),
+			       decltype(m54), decltype(m55), decltype(m56),
+			       decltype(m57), decltype(m58), decltype(m59),
+			       decltype(m60), decltype(m61), decltype(m62),
+			       decltype(m63)>{};
+    }
+    using type = decltype(ignore());
+
+    template<class U>
+    static auto tie(U& x) {
+	auto& [m0, m1, m2, m3, m4, m5, m6, m7, m8, m9, m10, m11, m12, m13,
+	       m14, m15, m16, m17, m18, m19, m20, m21, m22, m23, m24, m25,
+	       m26, m27, m28, m29, m30, m31, m32, m33, m34, m35, m36, m37,
+	       m38, m39, m40, m41, m42, m43, m44, m45, m46, m47, m48, m49,
+	       m50, m51, m52, m53, m54, m55, m56, m57, m58, m59, m60, m61,
+	       m62, m63] = x;
+	return std::tie(m0, m1, m2, m3, m4, m5, m6, m7, m8, m9, m10, m11,
+			m12, m13, m14, m15, m16, m17, m18, m19, m20, m21,
+			m22, m23, m24, m25, m26, m27, m28, m29, m30, m31,
+			m32, m33, m34, m35, m36, m37, m38, m39, m40, m41,
+			m42, m43, m44, m45, m46, m47, m48, m49, m50, m51,
+			m52, m53, m54, m55, m56, m57, m58, m59, m60, m61,
+			m62, m63);
+    }
+};
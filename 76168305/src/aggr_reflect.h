@@ -0,0 +1,139 @@
+// Copyright (C) 2022, 2023 by Mark Melton
+//
+
+#pragma once
+#include <climits>
+#include <cstddef>
+#include <type_traits>
+#include <utility>
+#include <tuple>
+
+// Can be used to aggregate initialize any type but on in an
+// unevaluation context since the call operator is declared but not
+// defined.
+struct universal_type {
+    std::size_t ignore;
+    template<class T>
+    constexpr operator T& () const;
+};
+
+// `constructible` has three overloads which can be used to determine
+// if T can be aggregate initlaized with a given number of arguments.
+
+// Can we aggregate initialize T with no arguements?
+template<class T, class U = decltype(T{})>
+constexpr bool constructible(std::index_sequence<>) {
+    return true;
+};
+
+// Can we aggregate initialize T with sizeof...(Ix) + 1 arguments?
+template<class T, size_t I, size_t... Ix,
+	 class U = decltype(T{universal_type{I}, universal_type{Ix}...})>
+constexpr bool constructible(std::index_sequence<I, Ix...>) {
+    return true;
+};
+
+// If neither of the other overloads are choosen, then we must not be
+// able to aggregate initialize T with sizeof...(Ix) arguments.
+template<class T, size_t... Ix>
+constexpr bool constructible(std::index_sequence<Ix...>) {
+    return false;
+};
+
+// Returns the number of members of T. Utilizes the contructible
+// overloads as helpers.
+//
+// T is constructible with any number of arguments up to its field
+// count and with none beyond, so the count is found by doubling N
+// until construction fails and then binary searching the last
+// interval. This instantiates `constructible` O(log n) times rather
+// than once for every candidate from sizeof(T) down. A struct cannot
+// have more members than it has bits (all single-bit bit-fields), which
+// bounds the search.
+template<class T>
+struct aggr_field_count {
+    static constexpr size_t max_fields = sizeof(T) * CHAR_BIT;
+
+    // The largest count in [Lo, Hi] with which T is constructible,
+    // given that it is constructible with Lo arguments.
+    template<size_t Lo, size_t Hi>
+    static consteval size_t search() {
+	if constexpr (Lo == Hi) {
+	    return Lo;
+	} else {
+	    constexpr size_t Mid = Lo + (Hi - Lo + 1) / 2;
+	    if constexpr (constructible<T>(std::make_index_sequence<Mid>{}))
+		return search<Mid, Hi>();
+	    else
+		return search<Lo, Mid - 1>();
+	}
+    }
+
+    // Given that T is constructible with N / 2 arguments, double N
+    // until it is not and then search the last interval.
+    template<size_t N>
+    static consteval size_t grow() {
+	if constexpr (N > max_fields)
+	    return search<N / 2, max_fields>();
+	else if constexpr (constructible<T>(std::make_index_sequence<N>{}))
+	    return grow<2 * N>();
+	else
+	    return search<N / 2, N - 1>();
+    }
+
+    static constexpr size_t value = grow<1>();
+};
+
+template<class T>
+inline constexpr auto aggr_field_count_v = aggr_field_count<T>::value;
+
+// Wrapper for containing field types.
+template<class... Ts>
+struct aggr_field_list {
+    using type = std::tuple<Ts...>;
+};
+
+// One specialization per field count binds the members with a
+// structured binding (which needs a fixed number of names) to recover
+// their types and to tie them. The specializations up to
+// AGGR_FIELD_LIMIT members are generated by gen_aggr_bindings.py.
+template<class T, size_t N>
+struct aggr_field_type_impl {
+    static_assert(sizeof(T) == 0, "too many fields: regenerate aggr_bindings.h with a larger limit");
+};
+
+#include "aggr_bindings.h"
+
+template<class T, size_t N = aggr_field_count_v<T>>
+using aggr_field_types = typename aggr_field_type_impl<T, N>::type::type;
+
+// Returns a tuple of references to the members of `x` (const
+// references if `x` is const).
+template<class T, size_t N = aggr_field_count_v<std::remove_const_t<T>>>
+auto aggr_tie(T& x) {
+    return aggr_field_type_impl<std::remove_const_t<T>, N>::tie(x);
+}
+
+// We want to detect scalars (except pointers) and structures that contains such.
+
+template<class T>
+struct criteria_impl;
+
+template<class T> requires (not std::is_aggregate_v<T>)
+struct criteria_impl<T> {
+    static constexpr bool value = std::is_scalar_v<T> and not std::is_pointer_v<T>;
+};
+
+template<class T> requires (std::is_aggregate_v<T>)
+struct criteria_impl<T> {
+    using U = aggr_field_types<T>;
+    static constexpr bool value = criteria_impl<U>::value;
+};
+
+template<class... Ts> 
+struct criteria_impl<std::tuple<Ts...>> {
+    static constexpr bool value = (criteria_impl<Ts>::value and ...);
+};
+
+template<class T>
+inline constexpr bool criteria_v = criteria_impl<T>::value;
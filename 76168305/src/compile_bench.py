@@ -0,0 +1,158 @@
+#!/usr/bin/env python3
+# Copyright (C) 2022, 2023 by Mark Melton
+"""Compile-time benchmark for the aggregate reflection in aggr_reflect.h.
+
+For each field count, generate a translation unit with a struct of
+that many members, reflect it with aggr_field_count_v and
+aggr_field_types, and time a syntax-only compile. The same struct
+compiled without reflection is used as a baseline so the report shows
+the cost of the reflection alone. Peak memory is the maximum resident
+set size of the compiler process.
+
+With --structs, instead generate a header with that many structs of
+mixed member types and counts (including multi-kilobyte members) and
+time compiling a translation unit that reflects all of them.
+
+  python3 compile_bench.py --cxx clang++ --flags="-std=c++2b -stdlib=libc++"
+  python3 compile_bench.py --field-type="std::array<char, 64>"
+  python3 compile_bench.py --structs 500
+"""
+
+import argparse
+import os
+import random
+import shlex
+import subprocess
+import sys
+import tempfile
+import time
+
+SRC_DIR = os.path.dirname(os.path.abspath(__file__))
+
+
+def struct_source(name, nfields, field_type):
+    members = "".join(f"    {field_type} m{i};\n" for i in range(nfields))
+    return f"struct {name} {{\n{members}}};\n"
+
+
+def reflect_source(name, nfields):
+    return (f"static_assert(aggr_field_count_v<{name}> == {nfields});\n"
+            f"static_assert(std::tuple_size_v<aggr_field_types<{name}>> == {nfields});\n")
+
+
+def translation_unit(nfields, field_type, reflect):
+    src = "#include <array>\n#include <cstdint>\n"
+    src += '#include "aggr_reflect.h"\n\n'
+    src += struct_source("S", nfields, field_type)
+    if reflect:
+        src += reflect_source("S", nfields)
+    return src
+
+
+MIXED_TYPES = ["char", "int", "double", "uint64_t", "std::array<char, 64>",
+               "std::array<double, 512>"]
+
+
+def many_structs_header(nstructs, seed=0):
+    rng = random.Random(seed)
+    src = "#pragma once\n#include <array>\n#include <cstdint>\n\n"
+    for i in range(nstructs):
+        nfields = rng.randint(1, 64)
+        members = "".join(f"    {rng.choice(MIXED_TYPES)} m{j};\n" for j in range(nfields))
+        src += f"struct R{i} {{\n{members}}};\n"
+        src += f"inline constexpr std::size_t R{i}_fields = {nfields};\n\n"
+    return src
+
+
+def many_structs_unit(nstructs, reflect):
+    src = '#include "aggr_reflect.h"\n#include "structs.h"\n\n'
+    if reflect:
+        for i in range(nstructs):
+            src += reflect_source(f"R{i}", f"R{i}_fields")
+    return src
+
+
+def run_many_structs(args, flags):
+    with tempfile.TemporaryDirectory() as tmp:
+        with open(os.path.join(tmp, "structs.h"), "w") as f:
+            f.write(many_structs_header(args.structs))
+        results = []
+        for reflect in (False, True):
+            path = os.path.join(tmp, f"many_{int(reflect)}.cpp")
+            with open(path, "w") as f:
+                f.write(many_structs_unit(args.structs, reflect))
+            results.append(best_of(args.repeat, args.cxx, flags, path))
+    (_, base, base_rss), (ok, secs, rss) = results
+    print(f"{'structs':>8s} {'baseline':>10s} {'reflect':>10s} {'delta':>10s} {'peak-rss':>10s}")
+    if not ok:
+        print(f"{args.structs:8d} {base * 1e3:8.0f}ms {'error':>10s}")
+        return 1
+    print(f"{args.structs:8d} {base * 1e3:8.0f}ms {secs * 1e3:8.0f}ms "
+          f"{(secs - base) * 1e3:8.0f}ms {rss:8.0f}MB")
+    print(f"{(secs - base) * 1e3 / args.structs:.2f} ms and "
+          f"{(rss - base_rss) / args.structs * 1024:.0f} KB per reflected struct")
+    return 0
+
+
+def compile_once(cxx, flags, path):
+    """Compile `path` and return (ok, seconds, peak rss in MB)."""
+    cmd = [cxx, *flags, "-fsyntax-only", "-I", SRC_DIR, path]
+    with tempfile.TemporaryFile() as log:
+        start = time.perf_counter()
+        proc = subprocess.Popen(cmd, stdout=subprocess.DEVNULL, stderr=log)
+        _, status, usage = os.wait4(proc.pid, 0)
+        elapsed = time.perf_counter() - start
+        log.seek(0)
+        err = log.read().decode(errors="replace")
+    rss_kb = usage.ru_maxrss / (1024 if sys.platform == "darwin" else 1)
+    ok = os.waitstatus_to_exitcode(status) == 0
+    if not ok:
+        errors = [line for line in err.splitlines() if "error" in line]
+        sys.stderr.write((errors or ["compile failed"])[0] + "\n")
+    return ok, elapsed, rss_kb / 1024
+
+
+def best_of(repeat, cxx, flags, path):
+    runs = [compile_once(cxx, flags, path) for _ in range(repeat)]
+    ok = all(r[0] for r in runs)
+    return ok, min(r[1] for r in runs), max(r[2] for r in runs)
+
+
+def main():
+    parser = argparse.ArgumentParser(description=__doc__,
+                                     formatter_class=argparse.RawDescriptionHelpFormatter)
+    parser.add_argument("--cxx", default=os.environ.get("CXX", "c++"))
+    parser.add_argument("--flags", default="-std=c++2b")
+    parser.add_argument("--fields", default="1,2,4,8,16,24,32,40,48,56,64",
+                        help="Comma separated field counts")
+    parser.add_argument("--field-type", default="int")
+    parser.add_argument("--structs", type=int, default=0,
+                        help="Reflect this many mixed structs in one translation unit")
+    parser.add_argument("--repeat", type=int, default=3)
+    args = parser.parse_args()
+
+    flags = shlex.split(args.flags)
+    if args.structs > 0:
+        return run_many_structs(args, flags)
+
+    counts = [int(n) for n in args.fields.split(",")]
+    print(f"{'fields':>8s} {'baseline':>10s} {'reflect':>10s} {'delta':>10s} {'peak-rss':>10s}")
+    with tempfile.TemporaryDirectory() as tmp:
+        for n in counts:
+            results = []
+            for reflect in (False, True):
+                path = os.path.join(tmp, f"s{n}_{int(reflect)}.cpp")
+                with open(path, "w") as f:
+                    f.write(translation_unit(n, args.field_type, reflect))
+                results.append(best_of(args.repeat, args.cxx, flags, path))
+            (_, base, _), (ok, secs, rss) = results
+            if not ok:
+                print(f"{n:8d} {base * 1e3:8.0f}ms {'error':>10s}")
+                continue
+            print(f"{n:8d} {base * 1e3:8.0f}ms {secs * 1e3:8.0f}ms "
+                  f"{(secs - base) * 1e3:8.0f}ms {rss:8.0f}MB")
+    return 0
+
+
+if __name__ == "__main__":
+    sys.exit(main())
@@ -0,0 +1,91 @@
+#!/usr/bin/env python3
+# Copyright (C) 2022, 2023 by Mark Melton
+"""Generate the aggr_field_type_impl specializations in aggr_bindings.h.
+
+Structured bindings need a fixed number of names, so there is one
+specialization per field count. Only the specialization matching a
+type's field count is ever instantiated, so adding more of them costs
+nothing beyond parsing.
+
+  python3 gen_aggr_bindings.py 64 > aggr_bindings.h
+"""
+
+import argparse
+
+
+def names(n):
+    return [f"m{i}" for i in range(n)]
+
+
+def indent_to(column):
+    return "\t" * (column // 8) + " " * (column % 8)
+
+
+def wrap(items, column, width=76):
+    indent = indent_to(column)
+    lines, line = [], ""
+    for item in items:
+        piece = item if not line else ", " + item
+        if column + len(line) + len(piece) > width and line:
+            lines.append(line + ",")
+            line = item
+        else:
+            line += piece
+    lines.append(line)
+    return ("\n" + indent).join(lines)
+
+
+def specialization(n):
+    ns = names(n)
+    if n == 0:
+        return """template<class T>
+struct aggr_field_type_impl<T, 0> {
+    static auto ignore() { return aggr_field_list<>{};  }
+    using type = decltype(ignore());
+
+    template<class U>
+    static auto tie(U&) { return std::tuple<>{}; }
+};
+"""
+    binding = wrap(ns, 8 + len("auto ["))
+    ref_binding = wrap(ns, 8 + len("auto& ["))
+    decls = wrap([f"decltype({m})" for m in ns], 8 + len("return aggr_field_list<"))
+    tie = wrap(ns, 8 + len("return std::tie("))
+    return f"""template<class T>
+struct aggr_field_type_impl<T, {n}> {{
+    static auto ignore() {{
+	T *x = nullptr;
+	auto [{binding}] = *x;
+	return aggr_field_list<{decls}>{{}};
+    }}
+    using type = decltype(ignore());
+
+    template<class U>
+    static auto tie(U& x) {{
+	auto& [{ref_binding}] = x;
+	return std::tie({tie});
+    }}
+}};
+"""
+
+
+def main():
+    parser = argparse.ArgumentParser(description=__doc__,
+                                     formatter_class=argparse.RawDescriptionHelpFormatter)
+    parser.add_argument("limit", nargs="?", type=int, default=64,
+                        help="Largest field count to specialize for (default 64)")
+    limit = parser.parse_args().limit
+    print("// Copyright (C) 2022, 2023 by Mark Melton")
+    print("//")
+    print("// Generated by gen_aggr_bindings.py -- do not edit.")
+    print("//")
+    print()
+    print("#pragma once")
+    print()
+    print(f"#define AGGR_FIELD_LIMIT {limit}")
+    print()
+    print("\n".join(specialization(n) for n in range(limit + 1)), end="")
+
+
+if __name__ == "__main__":
+    main()
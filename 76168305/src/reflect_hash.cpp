@@ -0,0 +1,217 @@
+// Copyright (C) 2022, 2023 by Mark Melton
+//
+
+#undef NDEBUG
+#include <cassert>
+
+#include <cstring>
+#include <unordered_map>
+#include "core/util/tool.h"
+#include "core/util/random.h"
+#include "core/chrono/stopwatch.h"
+#include "aggr_reflect.h"
+
+// Fold one 64-bit word into the running hash `h`: xor it in, multiply
+// by an odd constant and xor the high bits back down so they reach the
+// low bits a table index uses. One multiply per word keeps hashing
+// cheap relative to the table probe it feeds.
+constexpr uint64_t hash_step(uint64_t h, uint64_t word) {
+    h = (h ^ word) * 0xc6a4a7935bd1e995ull;
+    return h ^ (h >> 47);
+}
+
+// Hash `n` bytes eight at a time.
+inline uint64_t hash_bytes(const void *data, size_t n) {
+    auto ptr = static_cast<const unsigned char*>(data);
+    uint64_t h = 0x9e3779b97f4a7c15ull ^ n;
+    for (; n >= 8; n -= 8, ptr += 8) {
+	uint64_t word;
+	std::memcpy(&word, ptr, 8);
+	h = hash_step(h, word);
+    }
+    if (n > 0) {
+	uint64_t word{};
+	std::memcpy(&word, ptr, n);
+	h = hash_step(h, word);
+    }
+    return h;
+}
+
+// If every bit of a value's object representation participates in its
+// value (no padding, no floating point), equal values have identical
+// bytes and the whole object can be hashed and compared as a block.
+template<class T>
+inline constexpr bool is_bytewise_v =
+    std::is_trivially_copyable_v<T> and std::has_unique_object_representations_v<T>;
+
+// Hashes an aggregate over all of its members: as a single block of
+// bytes when `is_bytewise_v<T>` holds, otherwise by combining the
+// hashes of its members (recursing into member aggregates).
+template<class T>
+struct reflect_hash {
+    size_t operator()(const T& value) const {
+	if constexpr (is_bytewise_v<T>) {
+	    return hash_bytes(&value, sizeof(T));
+	} else if constexpr (std::is_aggregate_v<T> and not std::is_array_v<T>) {
+	    uint64_t h = 0x9e3779b97f4a7c15ull ^ aggr_field_count_v<T>;
+	    std::apply([&](const auto&... fields) {
+		((h = hash_step(h, field_hash(fields))), ...);
+	    }, aggr_tie(value));
+	    return h;
+	} else {
+	    return std::hash<T>{}(value);
+	}
+    }
+
+private:
+    template<class U>
+    static size_t field_hash(const U& field) {
+	return reflect_hash<U>{}(field);
+    }
+};
+
+// Compares aggregates member by member, or with a single memcmp when
+// `is_bytewise_v<T>` holds.
+template<class T>
+struct reflect_equal {
+    bool operator()(const T& a, const T& b) const {
+	if constexpr (is_bytewise_v<T>) {
+	    return std::memcmp(&a, &b, sizeof(T)) == 0;
+	} else if constexpr (std::is_aggregate_v<T> and not std::is_array_v<T>) {
+	    return std::apply([&](const auto&... fa) {
+		return std::apply([&](const auto&... fb) {
+		    return (field_equal(fa, fb) and ...);
+		}, aggr_tie(b));
+	    }, aggr_tie(a));
+	} else {
+	    return a == b;
+	}
+    }
+
+private:
+    template<class U>
+    static bool field_equal(const U& a, const U& b) {
+	return reflect_equal<U>{}(a, b);
+    }
+};
+
+// A padding-free key hashed as one block.
+struct RouteKey {
+    uint32_t source;
+    uint32_t destination;
+    uint64_t account;
+};
+
+// A key with a string and padding, hashed member by member.
+struct SymbolKey {
+    std::string symbol;
+    uint16_t venue;
+    double strike;
+};
+
+static_assert(is_bytewise_v<RouteKey>);
+static_assert(not is_bytewise_v<SymbolKey>);
+
+// The handwritten alternatives we are replacing.
+struct RouteKeyHash {
+    size_t operator()(const RouteKey& k) const {
+	size_t h = std::hash<uint32_t>{}(k.source);
+	h ^= std::hash<uint32_t>{}(k.destination) + 0x9e3779b9 + (h << 6) + (h >> 2);
+	h ^= std::hash<uint64_t>{}(k.account) + 0x9e3779b9 + (h << 6) + (h >> 2);
+	return h;
+    }
+};
+
+struct RouteKeyEqual {
+    bool operator()(const RouteKey& a, const RouteKey& b) const {
+	return a.source == b.source and a.destination == b.destination and a.account == b.account;
+    }
+};
+
+struct SymbolKeyHash {
+    size_t operator()(const SymbolKey& k) const {
+	size_t h = std::hash<std::string>{}(k.symbol);
+	h ^= std::hash<uint16_t>{}(k.venue) + 0x9e3779b9 + (h << 6) + (h >> 2);
+	h ^= std::hash<double>{}(k.strike) + 0x9e3779b9 + (h << 6) + (h >> 2);
+	return h;
+    }
+};
+
+struct SymbolKeyEqual {
+    bool operator()(const SymbolKey& a, const SymbolKey& b) const {
+	return a.symbol == b.symbol and a.venue == b.venue and a.strike == b.strike;
+    }
+};
+
+template<class Work>
+void measure(std::string_view desc, size_t nops, Work&& work) {
+    chron::StopWatch timer;
+    timer.mark();
+    auto r = work();
+    auto micros = timer.elapsed_duration<std::chrono::microseconds>().count();
+    auto mops = nops / std::max<double>(micros, 1);
+    cout << fmt::format("{:>24s}: {:6d} ms {:8.2f} Mops/s  ({})", desc, micros / 1000, mops, r)
+	 << endl;
+}
+
+// Insert `keys` into a map using Hash and Equal, then look up `probes`.
+template<class Hash, class Equal, class Key>
+void run(std::string_view desc, const std::vector<Key>& keys, const std::vector<Key>& probes) {
+    std::unordered_map<Key, size_t, Hash, Equal> map;
+    map.reserve(keys.size());
+    for (size_t i = 0; i < keys.size(); ++i)
+	map.emplace(keys[i], i);
+
+    measure(desc, probes.size(), [&]() {
+	size_t found{};
+	for (const auto& key : probes)
+	    found += map.count(key);
+	return found;
+    });
+}
+
+int tool_main(int argc, const char *argv[]) {
+    ArgParse opts
+	(
+	 argValue<'n'>("number", 1'000'000, "Number of keys"),
+	 argValue<'p'>("probes", 10'000'000, "Number of lookups")
+	 );
+    opts.parse(argc, argv);
+    auto n = opts.get<'n'>();
+    auto p = opts.get<'p'>();
+
+    std::uniform_int_distribution<uint32_t> d32;
+    std::uniform_int_distribution<uint64_t> d64;
+    std::vector<RouteKey> routes(n);
+    std::vector<SymbolKey> symbols(n);
+    for (auto i = 0; i < n; ++i) {
+	routes[i] = RouteKey{d32(core::rng()), d32(core::rng()), d64(core::rng())};
+	symbols[i] = SymbolKey{fmt::format("SYM{}", d32(core::rng()) % 5000),
+			       uint16_t(i % 16), 0.5 * (i % 400)};
+    }
+
+    // Half of the probes hit, half miss.
+    std::uniform_int_distribution<int> pick(0, n - 1);
+    std::vector<RouteKey> route_probes(p);
+    std::vector<SymbolKey> symbol_probes(p);
+    for (auto i = 0; i < p; ++i) {
+	route_probes[i] = routes[pick(core::rng())];
+	symbol_probes[i] = symbols[pick(core::rng())];
+	if (i % 2) {
+	    route_probes[i].account ^= 1;
+	    symbol_probes[i].strike += 1000.0;
+	}
+    }
+
+    assert(reflect_equal<SymbolKey>{}(symbols[0], symbols[0]));
+    assert(reflect_hash<SymbolKey>{}(symbols[0]) == reflect_hash<SymbolKey>{}(SymbolKey(symbols[0])));
+    assert(reflect_hash<SymbolKey>{}(SymbolKey{"A", 1, 0.0}) ==
+	   reflect_hash<SymbolKey>{}(SymbolKey{"A", 1, -0.0}));
+
+    run<RouteKeyHash, RouteKeyEqual>("route-handwritten", routes, route_probes);
+    run<reflect_hash<RouteKey>, reflect_equal<RouteKey>>("route-reflect", routes, route_probes);
+    run<SymbolKeyHash, SymbolKeyEqual>("symbol-handwritten", symbols, symbol_probes);
+    run<reflect_hash<SymbolKey>, reflect_equal<SymbolKey>>("symbol-reflect", symbols, symbol_probes);
+
+    return 0;
+}
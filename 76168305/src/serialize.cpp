@@ -0,0 +1,317 @@
+// Copyright (C) 2022, 2023 by Mark Melton
+//
+
+#undef NDEBUG
+#include <cassert>
+
+#include <cstring>
+#include <fstream>
+#include <span>
+#include <sstream>
+#include "core/util/tool.h"
+#include "core/chrono/stopwatch.h"
+#include "aggr_reflect.h"
+
+// Buffered binary output. Small writes are gathered into the buffer;
+// writes at least as large as the buffer go straight to the stream
+// without an intermediate copy.
+class BinaryWriter {
+public:
+    explicit BinaryWriter(std::ostream& os, size_t capacity = 1 << 16)
+	: os_(os)
+	, buffer_(capacity) {
+    }
+
+    ~BinaryWriter() {
+	flush();
+    }
+
+    BinaryWriter(const BinaryWriter&) = delete;
+    BinaryWriter& operator=(const BinaryWriter&) = delete;
+
+    void write_bytes(const void *data, size_t n) {
+	if (n > buffer_.size() - used_) {
+	    flush();
+	    if (n >= buffer_.size()) {
+		os_.write(static_cast<const char*>(data), n);
+		written_ += n;
+		return;
+	    }
+	}
+	std::memcpy(buffer_.data() + used_, data, n);
+	used_ += n;
+    }
+
+    void flush() {
+	os_.write(buffer_.data(), used_);
+	written_ += used_;
+	used_ = 0;
+    }
+
+    auto bytes_written() const {
+	return written_ + used_;
+    }
+
+private:
+    std::ostream& os_;
+    std::vector<char> buffer_;
+    size_t used_{}, written_{};
+};
+
+// Buffered binary input, the mirror of BinaryWriter. Throws
+// std::runtime_error if the stream ends before a read is satisfied.
+class BinaryReader {
+public:
+    explicit BinaryReader(std::istream& is, size_t capacity = 1 << 16)
+	: is_(is)
+	, buffer_(capacity) {
+    }
+
+    void read_bytes(void *data, size_t n) {
+	auto out = static_cast<char*>(data);
+	auto available = end_ - begin_;
+	if (n <= available) {
+	    std::memcpy(out, buffer_.data() + begin_, n);
+	    begin_ += n;
+	    return;
+	}
+
+	std::memcpy(out, buffer_.data() + begin_, available);
+	out += available;
+	n -= available;
+	begin_ = end_ = 0;
+
+	if (n >= buffer_.size()) {
+	    if (not is_.read(out, n))
+		throw std::runtime_error("BinaryReader: unexpected end of stream");
+	    return;
+	}
+
+	is_.read(buffer_.data(), buffer_.size());
+	end_ = is_.gcount();
+	if (end_ < n)
+	    throw std::runtime_error("BinaryReader: unexpected end of stream");
+	std::memcpy(out, buffer_.data(), n);
+	begin_ = n;
+    }
+
+private:
+    std::istream& is_;
+    std::vector<char> buffer_;
+    size_t begin_{}, end_{};
+};
+
+// Types that satisfy `criteria_v` (scalars other than pointers and
+// aggregates of such) and are trivially copyable are written as their
+// raw object representation. Everything else is walked member by
+// member.
+template<class T>
+inline constexpr bool is_blittable_v = std::is_trivially_copyable_v<T> and criteria_v<T>;
+
+template<class T>
+struct is_string : std::false_type { };
+
+template<class C, class Tr, class A>
+struct is_string<std::basic_string<C, Tr, A>> : std::true_type { };
+
+template<class T>
+struct is_vector : std::false_type { };
+
+template<class T, class A>
+struct is_vector<std::vector<T, A>> : std::true_type { };
+
+template<class T>
+void serialize(BinaryWriter& w, const T& value);
+
+template<class T>
+void deserialize(BinaryReader& r, T& value);
+
+// Serialize a contiguous run of records. Blittable records are written
+// as a single block.
+template<class T>
+void serialize(BinaryWriter& w, std::span<const T> values) {
+    if constexpr (is_blittable_v<T>) {
+	w.write_bytes(values.data(), values.size_bytes());
+    } else {
+	for (const auto& value : values)
+	    serialize(w, value);
+    }
+}
+
+template<class T>
+void deserialize(BinaryReader& r, std::span<T> values) {
+    if constexpr (is_blittable_v<T>) {
+	r.read_bytes(values.data(), values.size_bytes());
+    } else {
+	for (auto& value : values)
+	    deserialize(r, value);
+    }
+}
+
+template<class T>
+void serialize(BinaryWriter& w, const T& value) {
+    if constexpr (is_blittable_v<T>) {
+	w.write_bytes(&value, sizeof(T));
+    } else if constexpr (is_string<T>::value or is_vector<T>::value) {
+	uint64_t n = value.size();
+	w.write_bytes(&n, sizeof(n));
+	serialize(w, std::span<const typename T::value_type>(value.data(), value.size()));
+    } else if constexpr (std::is_pointer_v<T>) {
+	static_assert(not std::is_pointer_v<T>, "pointers cannot be serialized");
+    } else {
+	static_assert(std::is_aggregate_v<T>, "serialize: unsupported type");
+	std::apply([&](const auto&... fields) { (serialize(w, fields), ...); }, aggr_tie(value));
+    }
+}
+
+template<class T>
+void deserialize(BinaryReader& r, T& value) {
+    if constexpr (is_blittable_v<T>) {
+	r.read_bytes(&value, sizeof(T));
+    } else if constexpr (is_string<T>::value or is_vector<T>::value) {
+	uint64_t n{};
+	r.read_bytes(&n, sizeof(n));
+	value.resize(n);
+	deserialize(r, std::span<typename T::value_type>(value.data(), value.size()));
+    } else if constexpr (std::is_pointer_v<T>) {
+	static_assert(not std::is_pointer_v<T>, "pointers cannot be deserialized");
+    } else {
+	static_assert(std::is_aggregate_v<T>, "deserialize: unsupported type");
+	std::apply([&](auto&... fields) { (deserialize(r, fields), ...); }, aggr_tie(value));
+    }
+}
+
+// A pointer-free record that is written as a raw block.
+struct Tick {
+    uint64_t timestamp;
+    double price;
+    uint32_t quantity;
+    uint32_t venue;
+
+    bool operator==(const Tick&) const = default;
+};
+
+// A record with owning members that must be walked field by field.
+struct Order {
+    uint64_t id;
+    std::string symbol;
+    Tick tick;
+    std::vector<uint32_t> fills;
+
+    bool operator==(const Order&) const = default;
+};
+
+static_assert(is_blittable_v<Tick>);
+static_assert(not is_blittable_v<Order>);
+
+template<class T>
+std::string to_bytes(std::span<const T> values) {
+    std::ostringstream os;
+    BinaryWriter w(os);
+    serialize(w, values);
+    w.flush();
+    return os.str();
+}
+
+template<class Work>
+void measure(std::string_view desc, size_t nrecords, Work&& work) {
+    chron::StopWatch timer;
+    timer.mark();
+    size_t nbytes = work();
+    auto micros = timer.elapsed_duration<std::chrono::microseconds>().count();
+    auto secs = std::max<double>(micros, 1) / 1e6;
+    cout << fmt::format("{:>20s}: {:6d} ms {:8.1f} MB/s {:8.2f} Mrec/s",
+			desc, micros / 1000, nbytes / secs / 1e6, nrecords / secs / 1e6)
+	 << endl;
+}
+
+int tool_main(int argc, const char *argv[]) {
+    ArgParse opts
+	(
+	 argValue<'n'>("number", 1'000'000, "Number of records"),
+	 argValue<'o'>("output", std::string{}, "Write to this file instead of memory")
+	 );
+    opts.parse(argc, argv);
+    auto n = opts.get<'n'>();
+    auto path = opts.get<'o'>();
+
+    std::vector<Tick> ticks(n);
+    std::vector<Order> orders(n);
+    for (auto i = 0; i < n; ++i) {
+	ticks[i] = Tick{uint64_t(i), 100.0 + i * 0.01, uint32_t(i % 1000), uint32_t(i % 7)};
+	orders[i] = Order{uint64_t(i), fmt::format("SYM{}", i % 500), ticks[i], {}};
+	orders[i].fills.resize(i % 4, uint32_t(i));
+    }
+
+    auto make_sink = [&]() -> std::unique_ptr<std::ostream> {
+	if (path.empty()) return std::make_unique<std::ostringstream>();
+	return std::make_unique<std::ofstream>(path, std::ios::binary);
+    };
+
+    measure("tick-iostream-text", n, [&]() {
+	auto os = make_sink();
+	for (const auto& t : ticks)
+	    *os << t.timestamp << ' ' << t.price << ' ' << t.quantity << ' ' << t.venue << '\n';
+	return size_t(os->tellp());
+    });
+
+    measure("tick-iostream-fields", n, [&]() {
+	auto os = make_sink();
+	for (const auto& t : ticks) {
+	    os->write(reinterpret_cast<const char*>(&t.timestamp), sizeof(t.timestamp));
+	    os->write(reinterpret_cast<const char*>(&t.price), sizeof(t.price));
+	    os->write(reinterpret_cast<const char*>(&t.quantity), sizeof(t.quantity));
+	    os->write(reinterpret_cast<const char*>(&t.venue), sizeof(t.venue));
+	}
+	return size_t(os->tellp());
+    });
+
+    measure("tick-serialize", n, [&]() {
+	auto os = make_sink();
+	BinaryWriter w(*os);
+	serialize(w, std::span<const Tick>(ticks));
+	w.flush();
+	return w.bytes_written();
+    });
+
+    std::vector<Tick> ticks_in(n);
+    std::istringstream tick_is(to_bytes(std::span<const Tick>(ticks)));
+    measure("tick-deserialize", n, [&]() {
+	BinaryReader r(tick_is);
+	deserialize(r, std::span<Tick>(ticks_in));
+	return ticks_in.size() * sizeof(Tick);
+    });
+    assert(ticks_in == ticks);
+
+    measure("order-iostream-text", n, [&]() {
+	auto os = make_sink();
+	for (const auto& o : orders) {
+	    *os << o.id << ' ' << o.symbol << ' ' << o.tick.timestamp << ' ' << o.tick.price
+		<< ' ' << o.tick.quantity << ' ' << o.tick.venue << ' ' << o.fills.size();
+	    for (auto fill : o.fills)
+		*os << ' ' << fill;
+	    *os << '\n';
+	}
+	return size_t(os->tellp());
+    });
+
+    measure("order-serialize", n, [&]() {
+	auto os = make_sink();
+	BinaryWriter w(*os);
+	serialize(w, std::span<const Order>(orders));
+	w.flush();
+	return w.bytes_written();
+    });
+
+    std::vector<Order> orders_in(n);
+    auto order_data = to_bytes(std::span<const Order>(orders));
+    std::istringstream order_is(order_data);
+    measure("order-deserialize", n, [&]() {
+	BinaryReader r(order_is);
+	deserialize(r, std::span<Order>(orders_in));
+	return order_data.size();
+    });
+    assert(orders_in == orders);
+
+    return 0;
+}
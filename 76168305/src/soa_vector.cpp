@@ -0,0 +1,268 @@
+// Copyright (C) 2022, 2023 by Mark Melton
+//
+
+#undef NDEBUG
+#include <cassert>
+
+#include <span>
+#include "core/util/tool.h"
+#include "core/chrono/stopwatch.h"
+#include "aggr_reflect.h"
+
+// std::vector<bool> packs bits, so it has neither bool& elements nor
+// contiguous storage to span. bool members are stored one per byte in
+// this wrapper instead, which converts to and from bool.
+struct soa_bool {
+    soa_bool(bool value = false)
+	: value(value) {
+    }
+
+    operator bool() const {
+	return value;
+    }
+
+    bool value;
+};
+
+static_assert(sizeof(soa_bool) == sizeof(bool));
+
+// A vector of aggregates of type `T` stored as a struct of arrays:
+// each member of `T` lives in its own contiguous `std::vector`. Loops
+// that touch a single member walk one dense array instead of striding
+// over whole records, so every cache line fetched is fully used and
+// the compiler is free to vectorize.
+//
+// Elements are accessed through proxy references which read and write
+// the underlying columns, and each column is exposed as a span via
+// `field<I>()`. Columns for bool members hold `soa_bool`.
+template<class T>
+class soa_vector {
+public:
+    static_assert(std::is_aggregate_v<T>);
+
+    using value_type = T;
+    using size_type = size_t;
+    using field_types = aggr_field_types<T>;
+    static constexpr size_t field_count_v = aggr_field_count_v<T>;
+
+    template<size_t I>
+    using field_type = std::remove_cv_t<std::tuple_element_t<I, field_types>>;
+
+    template<size_t I>
+    using column_type = std::conditional_t<std::is_same_v<field_type<I>, bool>, soa_bool, field_type<I>>;
+
+private:
+    template<class Seq>
+    struct columns_impl;
+
+    template<size_t... Is>
+    struct columns_impl<std::index_sequence<Is...>> {
+	using type = std::tuple<std::vector<column_type<Is>>...>;
+    };
+
+    using Indices = std::make_index_sequence<field_count_v>;
+    using Columns = typename columns_impl<Indices>::type;
+
+public:
+    template<class Vector>
+    class basic_reference {
+    public:
+	basic_reference(Vector *vec, size_t idx)
+	    : vec_(vec)
+	    , idx_(idx) {
+	}
+
+	template<size_t I>
+	auto& get() const {
+	    return std::get<I>(vec_->columns_)[idx_];
+	}
+
+	operator T() const {
+	    return vec_->load(idx_, Indices{});
+	}
+
+	const basic_reference& operator=(const T& value) const requires (not std::is_const_v<Vector>) {
+	    vec_->store(idx_, value, Indices{});
+	    return *this;
+	}
+
+	const basic_reference& operator=(const basic_reference& other) const
+	    requires (not std::is_const_v<Vector>) {
+	    return *this = static_cast<T>(other);
+	}
+
+    private:
+	Vector *vec_;
+	size_t idx_;
+    };
+
+    using reference = basic_reference<soa_vector>;
+    using const_reference = basic_reference<const soa_vector>;
+
+    soa_vector() = default;
+
+    explicit soa_vector(size_t n) {
+	resize(n);
+    }
+
+    auto size() const {
+	return std::get<0>(columns_).size();
+    }
+
+    bool empty() const {
+	return size() == 0;
+    }
+
+    void reserve(size_t n) {
+	std::apply([&](auto&... cols) { (cols.reserve(n), ...); }, columns_);
+    }
+
+    void resize(size_t n) {
+	std::apply([&](auto&... cols) { (cols.resize(n), ...); }, columns_);
+    }
+
+    void clear() {
+	std::apply([&](auto&... cols) { (cols.clear(), ...); }, columns_);
+    }
+
+    void push_back(const T& value) {
+	push_back(value, Indices{});
+    }
+
+    void pop_back() {
+	std::apply([&](auto&... cols) { (cols.pop_back(), ...); }, columns_);
+    }
+
+    reference operator[](size_t idx) {
+	return reference(this, idx);
+    }
+
+    const_reference operator[](size_t idx) const {
+	return const_reference(this, idx);
+    }
+
+    // The contiguous column for member `I`.
+    template<size_t I>
+    std::span<column_type<I>> field() {
+	return std::get<I>(columns_);
+    }
+
+    template<size_t I>
+    std::span<const column_type<I>> field() const {
+	return std::get<I>(columns_);
+    }
+
+private:
+    template<size_t... Is>
+    T load(size_t idx, std::index_sequence<Is...>) const {
+	return T{std::get<Is>(columns_)[idx]...};
+    }
+
+    template<size_t... Is>
+    void store(size_t idx, const T& value, std::index_sequence<Is...>) {
+	auto fields = aggr_tie(value);
+	((std::get<Is>(columns_)[idx] = std::get<Is>(fields)), ...);
+    }
+
+    template<size_t... Is>
+    void push_back(const T& value, std::index_sequence<Is...>) {
+	auto fields = aggr_tie(value);
+	(std::get<Is>(columns_).push_back(std::get<Is>(fields)), ...);
+    }
+
+    Columns columns_;
+};
+
+// A representative record where the hot loop only needs `price`.
+struct Tick {
+    uint64_t timestamp;
+    double price;
+    uint32_t quantity;
+};
+
+static_assert(std::is_same_v<soa_vector<Tick>::field_type<1>, double>);
+
+struct Order {
+    uint32_t id;
+    bool filled;
+};
+
+static_assert(std::is_same_v<soa_vector<Order>::column_type<1>, soa_bool>);
+
+template<class Work>
+void measure(std::ostream& os, std::string_view desc, Work&& work) {
+    chron::StopWatch timer;
+    timer.mark();
+    auto r = work();
+    auto millis = timer.elapsed_duration<std::chrono::milliseconds>().count();
+    os << fmt::format("{:>16s}: {:5d} ms  ({})", desc, millis, r) << endl;
+}
+
+int tool_main(int argc, const char *argv[]) {
+    ArgParse opts
+	(
+	 argValue<'n'>("number", 10'000'000, "Number of records"),
+	 argValue<'r'>("repeat", 10, "Number of passes over the records")
+	 );
+    opts.parse(argc, argv);
+    auto n = opts.get<'n'>();
+    auto r = opts.get<'r'>();
+
+    std::vector<Tick> aos;
+    soa_vector<Tick> soa;
+    aos.reserve(n);
+    soa.reserve(n);
+    for (auto i = 0; i < n; ++i) {
+	Tick tick{uint64_t(i), 100.0 + (i % 100) * 0.01, uint32_t(i % 7)};
+	aos.push_back(tick);
+	soa.push_back(tick);
+    }
+
+    Tick t3 = soa[3];
+    assert(t3.timestamp == 3 and t3.quantity == 3);
+    soa[3] = Tick{3, t3.price, 4};
+    assert(soa[3].get<2>() == 4);
+    soa[3].get<2>() = 3;
+
+    soa_vector<Order> orders;
+    orders.push_back(Order{1, true});
+    orders.push_back(Order{2, false});
+    orders[1].get<1>() = true;
+    assert(static_cast<Order>(orders[1]).filled);
+    for (auto& filled : orders.field<1>())
+	filled = false;
+    assert(not static_cast<Order>(orders[0]).filled);
+
+    measure(cout, "aos-sum-price", [&]() {
+	double sum{};
+	for (auto k = 0; k < r; ++k)
+	    for (const auto& tick : aos)
+		sum += tick.price;
+	return sum;
+    });
+
+    measure(cout, "soa-sum-price", [&]() {
+	double sum{};
+	for (auto k = 0; k < r; ++k)
+	    for (auto price : soa.field<1>())
+		sum += price;
+	return sum;
+    });
+
+    measure(cout, "aos-scale-price", [&]() {
+	for (auto k = 0; k < r; ++k)
+	    for (auto& tick : aos)
+		tick.price *= 1.0001;
+	return aos[n - 1].price;
+    });
+
+    measure(cout, "soa-scale-price", [&]() {
+	auto prices = soa.field<1>();
+	for (auto k = 0; k < r; ++k)
+	    for (auto& price : prices)
+		price *= 1.0001;
+	return prices[n - 1];
+    });
+
+    return 0;
+}
@@ -1,7 +1,25 @@
 // Copyright (C) 2022, 2023 by Mark Melton
 //
 
+#include <algorithm>
+#include <bit>
+#include <cstdint>
+#include <cstdio>
+#include <cstring>
 #include <iostream>
+#include <optional>
+#include <random>
+#include <span>
+#include <string>
+#include <string_view>
+#include <type_traits>
+#include <vector>
+#if defined(__AVX2__)
+#include <immintrin.h>
+#elif defined(__SSE2__)
+#include <emmintrin.h>
+#endif
+#include "core/timer/timer.h"
 
 using std::cout, std::endl;
 
@@ -55,6 +73,1094 @@ uint32_t utf8_sequence_to_codepoint(Iterator iter) {
         return 0xFFFF'FFFF;
 }
 
+// Bulk UTF-8 validation and transcoding.
+//
+// The functions above handle one code point at a time and trust their
+// input. The functions below work on whole buffers and reject
+// malformed UTF-8: bad lead or continuation bytes, truncated and
+// overlong sequences, surrogates and code points past U+10FFFF. The
+// transcoders return the number of code units written, or nullopt for
+// invalid input or an output span that is too small. Decoding UTF-8
+// never needs more than in.size() code units; encoding needs up to 3
+// bytes per UTF-16 and 4 per UTF-32 unit, and the *_length_from_*
+// functions give the exact size. Multi-byte loads assume a
+// little-endian host.
+
+// The length of the sequence introduced by `lead`, or 0 if it cannot
+// start a well-formed sequence.
+inline int utf8_sequence_length(uint8_t lead) {
+    if (lead < 0x80) return 1;
+    if (lead < 0xC2) return 0;
+    if (lead < 0xE0) return 2;
+    if (lead < 0xF0) return 3;
+    if (lead < 0xF5) return 4;
+    return 0;
+}
+
+// Decode and validate the sequence at `ptr` with `n` bytes available.
+// Returns its length, or 0 if it is malformed or truncated.
+inline int decode_utf8(const uint8_t *ptr, size_t n, char32_t& code) {
+    auto len = utf8_sequence_length(ptr[0]);
+    if (len == 0 or size_t(len) > n)
+	return 0;
+    for (int i = 1; i < len; ++i)
+	if ((ptr[i] bitand 0xC0) != 0x80)
+	    return 0;
+    switch (len) {
+    case 1:
+	code = ptr[0];
+	return 1;
+    case 2:
+	code = (ptr[0] bitand 0x1F) << 6 bitor (ptr[1] bitand 0x3F);
+	return 2;
+    case 3:
+	code = (ptr[0] bitand 0x0F) << 12 bitor (ptr[1] bitand 0x3F) << 6 bitor (ptr[2] bitand 0x3F);
+	return code >= 0x800 and (code < 0xD800 or code > 0xDFFF) ? 3 : 0;
+    default:
+	code = (ptr[0] bitand 0x07) << 18 bitor (ptr[1] bitand 0x3F) << 12
+	    bitor (ptr[2] bitand 0x3F) << 6 bitor (ptr[3] bitand 0x3F);
+	return code >= 0x1'0000 and code <= 0x10'FFFF ? 4 : 0;
+    }
+}
+
+// Encode `code` at `out` if it is a valid scalar value and fits before
+// `end`. Returns the number of bytes written, or 0.
+inline int encode_utf8(char32_t code, uint8_t *out, const uint8_t *end) {
+    int len = code < 0x80 ? 1 : code < 0x800 ? 2 : code < 0x1'0000 ? 3 : 4;
+    if ((code >= 0xD800 and code <= 0xDFFF) or code > 0x10'FFFF or end - out < len)
+	return 0;
+    switch (len) {
+    case 1:
+	out[0] = code;
+	break;
+    case 2:
+	out[0] = 0xC0 bitor (code >> 6);
+	out[1] = 0x80 bitor (code bitand 0x3F);
+	break;
+    case 3:
+	out[0] = 0xE0 bitor (code >> 12);
+	out[1] = 0x80 bitor ((code >> 6) bitand 0x3F);
+	out[2] = 0x80 bitor (code bitand 0x3F);
+	break;
+    default:
+	out[0] = 0xF0 bitor (code >> 18);
+	out[1] = 0x80 bitor ((code >> 12) bitand 0x3F);
+	out[2] = 0x80 bitor ((code >> 6) bitand 0x3F);
+	out[3] = 0x80 bitor (code bitand 0x3F);
+	break;
+    }
+    return len;
+}
+
+// Decode the code point at `ptr` with `n` UTF-16 units available.
+// Returns the number of units used, or 0 for an unpaired surrogate.
+inline int decode_utf16(const char16_t *ptr, size_t n, char32_t& code) {
+    char32_t unit = ptr[0];
+    if (unit < 0xD800 or unit > 0xDFFF) {
+	code = unit;
+	return 1;
+    }
+    if (unit > 0xDBFF or n < 2 or ptr[1] < 0xDC00 or ptr[1] > 0xDFFF)
+	return 0;
+    code = 0x1'0000 + ((unit - 0xD800) << 10) + (ptr[1] - 0xDC00);
+    return 2;
+}
+
+// Encode `code` (a valid scalar value) as one unit or a surrogate
+// pair at `out` if it fits before `end`. Returns the units written.
+inline int encode_utf16(char32_t code, char16_t *out, const char16_t *end) {
+    if (code < 0x1'0000) {
+	if (out == end)
+	    return 0;
+	out[0] = code;
+	return 1;
+    }
+    if (end - out < 2)
+	return 0;
+    out[0] = 0xD7C0 + (code >> 10);
+    out[1] = 0xDC00 bitor (code bitand 0x3FF);
+    return 2;
+}
+
+// The number of leading ASCII bytes, checked a vector or a word at a
+// time.
+inline size_t ascii_prefix(const uint8_t *ptr, size_t n) {
+    size_t i = 0;
+#if defined(__AVX2__)
+    for (; i + 32 <= n; i += 32) {
+	auto v = _mm256_loadu_si256(reinterpret_cast<const __m256i*>(ptr + i));
+	if (auto mask = uint32_t(_mm256_movemask_epi8(v)))
+	    return i + std::countr_zero(mask);
+    }
+#elif defined(__SSE2__)
+    for (; i + 16 <= n; i += 16) {
+	auto v = _mm_loadu_si128(reinterpret_cast<const __m128i*>(ptr + i));
+	if (auto mask = uint32_t(_mm_movemask_epi8(v)))
+	    return i + std::countr_zero(mask);
+    }
+#endif
+    for (; i + 8 <= n; i += 8) {
+	uint64_t word;
+	std::memcpy(&word, ptr + i, sizeof(word));
+	if (auto high = word bitand 0x8080'8080'8080'8080ull)
+	    return i + std::countr_zero(high) / 8;
+    }
+    while (i < n and ptr[i] < 0x80)
+	++i;
+    return i;
+}
+
+// Kernels that skip ASCII runs in bulk and handle everything else a
+// sequence at a time.
+namespace portable {
+
+bool validate_utf8(std::span<const uint8_t> in) {
+    const auto ptr = in.data();
+    const auto n = in.size();
+    for (size_t i = 0; i < n; ) {
+	i += ascii_prefix(ptr + i, n - i);
+	if (i == n)
+	    break;
+	char32_t code;
+	auto len = decode_utf8(ptr + i, n - i, code);
+	if (len == 0)
+	    return false;
+	i += len;
+    }
+    return true;
+}
+
+std::optional<size_t> utf8_to_utf32(std::span<const uint8_t> in, std::span<char32_t> out) {
+    const auto ptr = in.data();
+    const auto n = in.size();
+    auto o = out.data();
+    const auto end = out.data() + out.size();
+    for (size_t i = 0; i < n; ) {
+	auto run = ascii_prefix(ptr + i, n - i);
+	if (run > size_t(end - o))
+	    return std::nullopt;
+	for (size_t j = 0; j < run; ++j)
+	    o[j] = ptr[i + j];
+	o += run;
+	i += run;
+	if (i == n)
+	    break;
+	char32_t code;
+	auto len = decode_utf8(ptr + i, n - i, code);
+	if (len == 0 or o == end)
+	    return std::nullopt;
+	*o++ = code;
+	i += len;
+    }
+    return o - out.data();
+}
+
+std::optional<size_t> utf32_to_utf8(std::span<const char32_t> in, std::span<uint8_t> out) {
+    auto o = out.data();
+    const auto end = out.data() + out.size();
+    for (auto code : in) {
+	if (code < 0x80 and o < end) {
+	    *o++ = code;
+	    continue;
+	}
+	auto len = encode_utf8(code, o, end);
+	if (len == 0)
+	    return std::nullopt;
+	o += len;
+    }
+    return o - out.data();
+}
+
+std::optional<size_t> utf8_to_utf16(std::span<const uint8_t> in, std::span<char16_t> out) {
+    const auto ptr = in.data();
+    const auto n = in.size();
+    auto o = out.data();
+    const auto end = out.data() + out.size();
+    for (size_t i = 0; i < n; ) {
+	auto run = ascii_prefix(ptr + i, n - i);
+	if (run > size_t(end - o))
+	    return std::nullopt;
+	for (size_t j = 0; j < run; ++j)
+	    o[j] = ptr[i + j];
+	o += run;
+	i += run;
+	if (i == n)
+	    break;
+	char32_t code;
+	auto len = decode_utf8(ptr + i, n - i, code);
+	auto units = len ? encode_utf16(code, o, end) : 0;
+	if (units == 0)
+	    return std::nullopt;
+	o += units;
+	i += len;
+    }
+    return o - out.data();
+}
+
+std::optional<size_t> utf16_to_utf8(std::span<const char16_t> in, std::span<uint8_t> out) {
+    const auto ptr = in.data();
+    const auto n = in.size();
+    auto o = out.data();
+    const auto end = out.data() + out.size();
+    for (size_t i = 0; i < n; ) {
+	if (ptr[i] < 0x80 and o < end) {
+	    *o++ = ptr[i++];
+	    continue;
+	}
+	char32_t code;
+	auto units = decode_utf16(ptr + i, n - i, code);
+	auto len = units ? encode_utf8(code, o, end) : 0;
+	if (len == 0)
+	    return std::nullopt;
+	o += len;
+	i += units;
+    }
+    return o - out.data();
+}
+
+// The number of code points in valid UTF-8: every byte that is not a
+// continuation byte (10xxxxxx) starts one. Counted a word at a time.
+size_t count_codepoints(std::span<const uint8_t> in) {
+    const auto ptr = in.data();
+    const auto n = in.size();
+    size_t count{}, i = 0;
+    for (; i + 8 <= n; i += 8) {
+	uint64_t word;
+	std::memcpy(&word, ptr + i, sizeof(word));
+	auto conts = word bitand ~(word << 1) bitand 0x8080'8080'8080'8080ull;
+	count += 8 - std::popcount(conts);
+    }
+    for (; i < n; ++i)
+	count += (ptr[i] bitand 0xC0) != 0x80;
+    return count;
+}
+
+// The number of UTF-16 units for valid UTF-8: one per code point plus
+// one more for each 4-byte lead (11110xxx), which needs a pair.
+size_t utf16_length_from_utf8(std::span<const uint8_t> in) {
+    const auto ptr = in.data();
+    const auto n = in.size();
+    size_t count = count_codepoints(in), i = 0;
+    for (; i + 8 <= n; i += 8) {
+	uint64_t word;
+	std::memcpy(&word, ptr + i, sizeof(word));
+	auto fours = word bitand (word << 1) bitand (word << 2) bitand (word << 3);
+	count += std::popcount(fours bitand 0x8080'8080'8080'8080ull);
+    }
+    for (; i < n; ++i)
+	count += ptr[i] >= 0xF0;
+    return count;
+}
+
+size_t utf8_length_from_utf32(std::span<const char32_t> in) {
+    size_t count{};
+    for (auto code : in)
+	count += 1 + (code >= 0x80) + (code >= 0x800) + (code >= 0x1'0000);
+    return count;
+}
+
+// A surrogate pair is 4 bytes, 2 for each half.
+size_t utf8_length_from_utf16(std::span<const char16_t> in) {
+    size_t count{};
+    for (auto unit : in)
+	count += 1 + (unit >= 0x80) + (unit >= 0x800) - ((unit bitand 0xF800) == 0xD800);
+    return count;
+}
+
+} // namespace portable
+
+#if defined(__AVX2__)
+namespace avx2 {
+
+// The lookup validation of Keiser and Lemire, "Validating UTF-8 In
+// Less Than One Instruction Per Byte": three 16-entry table lookups on
+// the nibbles of each byte and its predecessor flag every two-byte
+// error pattern; a saturating subtract finds the bytes that must be
+// the 2nd or 3rd continuation of a 3 or 4 byte sequence.
+constexpr uint8_t TooShort = 1 << 0;	// 11______ 0_______ or 11______ 11______
+constexpr uint8_t TooLong = 1 << 1;	// 0_______ 10______
+constexpr uint8_t Overlong3 = 1 << 2;	// 11100000 100_____
+constexpr uint8_t TooLarge = 1 << 3;	// 11110100 1001____ and above
+constexpr uint8_t Surrogate = 1 << 4;	// 11101101 101_____
+constexpr uint8_t Overlong2 = 1 << 5;	// 1100000_ 10______
+constexpr uint8_t TooLarge1000 = 1 << 6; // 11110101 1000____ and above
+constexpr uint8_t Overlong4 = 1 << 6;	// 11110000 1000____
+constexpr uint8_t TwoConts = 1 << 7;	// 10______ 10______
+constexpr uint8_t Carry = TooShort bitor TooLong bitor TwoConts;
+
+template<uint8_t... Table>
+inline __m256i lookup16(__m256i idx) {
+    static_assert(sizeof...(Table) == 16);
+    return _mm256_shuffle_epi8(_mm256_setr_epi8(char(Table)..., char(Table)...), idx);
+}
+
+inline __m256i high_nibbles(__m256i v) {
+    return _mm256_and_si256(_mm256_srli_epi16(v, 4), _mm256_set1_epi8(0x0F));
+}
+
+// The input shifted by N bytes, with the last N bytes of the previous
+// block shifted in.
+template<int N>
+inline __m256i prev(__m256i input, __m256i prev_input) {
+    return _mm256_alignr_epi8(input, _mm256_permute2x128_si256(prev_input, input, 0x21), 16 - N);
+}
+
+inline __m256i special_cases(__m256i input, __m256i prev1) {
+    auto byte_1_high = lookup16<
+	TooLong, TooLong, TooLong, TooLong, TooLong, TooLong, TooLong, TooLong,
+	TwoConts, TwoConts, TwoConts, TwoConts,
+	TooShort bitor Overlong2,
+	TooShort,
+	TooShort bitor Overlong3 bitor Surrogate,
+	TooShort bitor TooLarge bitor TooLarge1000 bitor Overlong4>(high_nibbles(prev1));
+    auto byte_1_low = lookup16<
+	Carry bitor Overlong3 bitor Overlong2 bitor Overlong4,
+	Carry bitor Overlong2,
+	Carry,
+	Carry,
+	Carry bitor TooLarge,
+	Carry bitor TooLarge bitor TooLarge1000,
+	Carry bitor TooLarge bitor TooLarge1000,
+	Carry bitor TooLarge bitor TooLarge1000,
+	Carry bitor TooLarge bitor TooLarge1000,
+	Carry bitor TooLarge bitor TooLarge1000,
+	Carry bitor TooLarge bitor TooLarge1000,
+	Carry bitor TooLarge bitor TooLarge1000,
+	Carry bitor TooLarge bitor TooLarge1000,
+	Carry bitor TooLarge bitor TooLarge1000 bitor Surrogate,
+	Carry bitor TooLarge bitor TooLarge1000,
+	Carry bitor TooLarge bitor TooLarge1000>(_mm256_and_si256(prev1, _mm256_set1_epi8(0x0F)));
+    auto byte_2_high = lookup16<
+	TooShort, TooShort, TooShort, TooShort, TooShort, TooShort, TooShort, TooShort,
+	TooLong bitor Overlong2 bitor TwoConts bitor Overlong3 bitor TooLarge1000 bitor Overlong4,
+	TooLong bitor Overlong2 bitor TwoConts bitor Overlong3 bitor TooLarge,
+	TooLong bitor Overlong2 bitor TwoConts bitor Surrogate bitor TooLarge,
+	TooLong bitor Overlong2 bitor TwoConts bitor Surrogate bitor TooLarge,
+	TooShort, TooShort, TooShort, TooShort>(high_nibbles(input));
+    return _mm256_and_si256(_mm256_and_si256(byte_1_high, byte_1_low), byte_2_high);
+}
+
+// Accumulates errors over consecutive 32-byte blocks.
+class Utf8Checker {
+public:
+    void check(__m256i input) {
+	if (_mm256_movemask_epi8(input) == 0) {
+	    // An ASCII block is only an error if the previous block ended
+	    // inside a sequence.
+	    error_ = _mm256_or_si256(error_, prev_incomplete_);
+	} else {
+	    auto prev1 = prev<1>(input, prev_input_);
+	    auto sc = special_cases(input, prev1);
+	    auto is_third = _mm256_subs_epu8(prev<2>(input, prev_input_), _mm256_set1_epi8(0xE0 - 0x80));
+	    auto is_fourth = _mm256_subs_epu8(prev<3>(input, prev_input_), _mm256_set1_epi8(0xF0 - 0x80));
+	    auto must23 = _mm256_and_si256(_mm256_or_si256(is_third, is_fourth), _mm256_set1_epi8(0x80));
+	    error_ = _mm256_or_si256(error_, _mm256_xor_si256(must23, sc));
+	    prev_incomplete_ = _mm256_subs_epu8(input, incomplete_limits());
+	}
+	prev_input_ = input;
+    }
+
+    // Check `n` < 32 trailing bytes, padded with ASCII zeros.
+    void check_tail(const uint8_t *ptr, size_t n) {
+	alignas(32) uint8_t block[32] = {};
+	std::memcpy(block, ptr, n);
+	check(_mm256_load_si256(reinterpret_cast<const __m256i*>(block)));
+    }
+
+    bool valid() {
+	error_ = _mm256_or_si256(error_, prev_incomplete_);
+	return _mm256_testz_si256(error_, error_);
+    }
+
+private:
+    // Lead bytes in the last three positions that need more bytes.
+    static __m256i incomplete_limits() {
+	return _mm256_setr_epi8(-1, -1, -1, -1, -1, -1, -1, -1, -1, -1, -1, -1, -1, -1, -1, -1,
+				-1, -1, -1, -1, -1, -1, -1, -1, -1, -1, -1, -1, -1,
+				char(0xF0 - 1), char(0xE0 - 1), char(0xC0 - 1));
+    }
+
+    __m256i error_ = _mm256_setzero_si256();
+    __m256i prev_input_ = _mm256_setzero_si256();
+    __m256i prev_incomplete_ = _mm256_setzero_si256();
+};
+
+inline __m256i load(const uint8_t *ptr) {
+    return _mm256_loadu_si256(reinterpret_cast<const __m256i*>(ptr));
+}
+
+bool validate_utf8(std::span<const uint8_t> in) {
+    Utf8Checker checker;
+    size_t i = 0;
+    for (; i + 32 <= in.size(); i += 32)
+	checker.check(load(in.data() + i));
+    if (i < in.size())
+	checker.check_tail(in.data() + i, in.size() - i);
+    return checker.valid();
+}
+
+// Decode one sequence already known to be well formed without
+// branches: the length and the payload masks come from a table indexed
+// by the lead byte's high nibble, and the payload bits of up to four
+// bytes (loaded big-endian) are gathered with shifts and masks. Always
+// reads 4 bytes.
+inline int decode_utf8_valid(const uint8_t *ptr, char32_t& code) {
+    struct Lead { uint32_t len, low, third; };
+    static constexpr Lead leads[16] = {
+	{ 1, 0x7F, 0 }, { 1, 0x7F, 0 }, { 1, 0x7F, 0 }, { 1, 0x7F, 0 },
+	{ 1, 0x7F, 0 }, { 1, 0x7F, 0 }, { 1, 0x7F, 0 }, { 1, 0x7F, 0 },
+	{ 1, 0x7F, 0 }, { 1, 0x7F, 0 }, { 1, 0x7F, 0 }, { 1, 0x7F, 0 },
+	{ 2, 0x3F, 0 }, { 2, 0x3F, 0 }, { 3, 0x3F, 0xF000 }, { 4, 0x3F, 0x3'F000 }
+    };
+    const auto& lead = leads[ptr[0] >> 4];
+    uint32_t word;
+    std::memcpy(&word, ptr, sizeof(word));
+    uint32_t v = __builtin_bswap32(word) >> (32 - 8 * lead.len);
+    code = (v bitand lead.low) bitor ((v >> 2) bitand 0xFC0)
+	bitor ((v >> 4) bitand lead.third) bitor ((v >> 6) bitand 0x1C'0000);
+    return lead.len;
+}
+
+// Encode one code point without branches, always storing 4 bytes.
+// Surrogates and values past U+10FFFF set `bad`.
+inline int encode_utf8_unchecked(char32_t code, uint8_t *out, bool& bad) {
+    static constexpr uint32_t markers[5] = { 0, 0, 0xC080, 0xE0'8080, 0xF080'8080 };
+    static constexpr uint32_t low[5] = { 0, 0x7F, 0x3F, 0x3F, 0x3F };
+    static constexpr uint32_t keep[5] = { 0, 0xFF, 0xFFFF, 0xFF'FFFF, 0xFFFF'FFFF };
+    int len = 1 + (code >= 0x80) + (code >= 0x800) + (code >= 0x1'0000);
+    uint32_t t = (code bitand low[len]) bitor ((code << 2) bitand 0x3F00)
+	bitor ((code << 4) bitand 0x3F'0000) bitor ((code << 6) bitand 0x700'0000);
+    t &= keep[len];
+    uint32_t word = __builtin_bswap32((t bitor markers[len]) << (8 * (4 - len)));
+    std::memcpy(out, &word, sizeof(word));
+    bad |= (code - 0xD800 < 0x800) bitor (code > 0x10'FFFF);
+    return len;
+}
+
+// Validation runs block by block with Utf8Checker while decoding
+// follows: ASCII blocks are widened 8 bytes to 8 code points at a time,
+// and in other blocks the positions of the lead bytes come from one
+// compare and movemask, so each sequence is decoded independently of
+// the length of the one before. Decoded output is only returned if the
+// whole input checks.
+std::optional<size_t> utf8_to_utf32(std::span<const uint8_t> in, std::span<char32_t> out) {
+    const auto ptr = in.data();
+    const auto n = in.size();
+    auto o = out.data();
+    const auto end = out.data() + out.size();
+    Utf8Checker checker;
+
+    // A block decodes to at most 32 code points and a sequence starting
+    // in it reads at most 3 bytes past it.
+    size_t b = 0;
+    for (; b + 32 + 3 <= n and end - o >= 32; b += 32) {
+	auto input = load(ptr + b);
+	checker.check(input);
+	if (_mm256_movemask_epi8(input) == 0) {
+	    auto lo = _mm256_castsi256_si128(input), hi = _mm256_extracti128_si256(input, 1);
+	    auto dst = reinterpret_cast<__m256i*>(o);
+	    _mm256_storeu_si256(dst + 0, _mm256_cvtepu8_epi32(lo));
+	    _mm256_storeu_si256(dst + 1, _mm256_cvtepu8_epi32(_mm_srli_si128(lo, 8)));
+	    _mm256_storeu_si256(dst + 2, _mm256_cvtepu8_epi32(hi));
+	    _mm256_storeu_si256(dst + 3, _mm256_cvtepu8_epi32(_mm_srli_si128(hi, 8)));
+	    o += 32;
+	    continue;
+	}
+	// Continuation bytes are 0x80..0xBF, i.e. less than -64 signed.
+	auto conts = _mm256_cmpgt_epi8(_mm256_set1_epi8(-64), input);
+	for (auto leads = ~uint32_t(_mm256_movemask_epi8(conts)); leads; leads &= leads - 1)
+	    decode_utf8_valid(ptr + b + std::countr_zero(leads), *o++);
+    }
+
+    // Check the remaining blocks, then finish with the checked decoder
+    // from the first lead byte at or after `b`.
+    for (auto j = b; j < n; j += 32) {
+	if (n - j >= 32)
+	    checker.check(load(ptr + j));
+	else
+	    checker.check_tail(ptr + j, n - j);
+    }
+    if (not checker.valid())
+	return std::nullopt;
+    while (b < n and (ptr[b] bitand 0xC0) == 0x80)
+	++b;
+    auto rest = portable::utf8_to_utf32(in.subspan(b), std::span<char32_t>(o, end));
+    if (not rest)
+	return std::nullopt;
+    return (o - out.data()) + *rest;
+}
+
+// Runs of 32 ASCII code points are narrowed with two saturating packs
+// and a lane fix-up; other code points are encoded branch-free.
+std::optional<size_t> utf32_to_utf8(std::span<const char32_t> in, std::span<uint8_t> out) {
+    const auto ptr = in.data();
+    const auto n = in.size();
+    auto o = out.data();
+    const auto end = out.data() + out.size();
+    const auto not_ascii = _mm256_set1_epi32(~0x7F);
+    const auto order = _mm256_setr_epi32(0, 4, 1, 5, 2, 6, 3, 7);
+
+    size_t i = 0;
+    while (i + 32 <= n) {
+	auto src = reinterpret_cast<const __m256i*>(ptr + i);
+	auto a = _mm256_loadu_si256(src + 0), b = _mm256_loadu_si256(src + 1);
+	auto c = _mm256_loadu_si256(src + 2), d = _mm256_loadu_si256(src + 3);
+	auto any = _mm256_or_si256(_mm256_or_si256(a, b), _mm256_or_si256(c, d));
+	if (_mm256_testz_si256(any, not_ascii) and end - o >= 32) {
+	    auto bytes = _mm256_packus_epi16(_mm256_packus_epi32(a, b), _mm256_packus_epi32(c, d));
+	    _mm256_storeu_si256(reinterpret_cast<__m256i*>(o), _mm256_permutevar8x32_epi32(bytes, order));
+	    o += 32;
+	    i += 32;
+	    continue;
+	}
+	// Up to 4 bytes per code point, stored 4 at a time.
+	if (end - o < 4 * 32)
+	    break;
+	bool bad{};
+	for (auto last = i + 32; i < last; ++i)
+	    o += encode_utf8_unchecked(ptr[i], o, bad);
+	if (bad)
+	    return std::nullopt;
+    }
+    auto rest = portable::utf32_to_utf8(in.subspan(i), std::span<uint8_t>(o, end));
+    if (not rest)
+	return std::nullopt;
+    return (o - out.data()) + *rest;
+}
+
+// As utf8_to_utf32, writing one unit per code point below U+10000 and a
+// surrogate pair otherwise, always as a 4-byte store.
+std::optional<size_t> utf8_to_utf16(std::span<const uint8_t> in, std::span<char16_t> out) {
+    const auto ptr = in.data();
+    const auto n = in.size();
+    auto o = out.data();
+    const auto end = out.data() + out.size();
+    Utf8Checker checker;
+
+    // Blocks are decoded before the checker has seen them, so the space
+    // a block needs is counted from its lead bytes rather than assumed:
+    // every byte from 0xF0 up decodes to a pair, even when malformed,
+    // so a bad block can yield 64 units. Valid blocks yield at most 32.
+    // A block that may not fit (plus 1 for the last 4-byte store) is
+    // left to the portable path, which checks every write.
+    size_t b = 0;
+    for (; b + 32 + 3 <= n; b += 32) {
+	auto input = load(ptr + b);
+	auto conts = _mm256_cmpgt_epi8(_mm256_set1_epi8(-64), input);
+	auto leads = ~uint32_t(_mm256_movemask_epi8(conts));
+	auto pairs = uint32_t(_mm256_movemask_epi8(_mm256_cmpgt_epi8(input, _mm256_set1_epi8(-17))))
+	    bitand uint32_t(_mm256_movemask_epi8(input));
+	if (end - o < std::popcount(leads) + std::popcount(pairs) + 1)
+	    break;
+	checker.check(input);
+	if (_mm256_movemask_epi8(input) == 0) {
+	    auto dst = reinterpret_cast<__m256i*>(o);
+	    _mm256_storeu_si256(dst + 0, _mm256_cvtepu8_epi16(_mm256_castsi256_si128(input)));
+	    _mm256_storeu_si256(dst + 1, _mm256_cvtepu8_epi16(_mm256_extracti128_si256(input, 1)));
+	    o += 32;
+	    continue;
+	}
+	for (; leads; leads &= leads - 1) {
+	    char32_t code;
+	    decode_utf8_valid(ptr + b + std::countr_zero(leads), code);
+	    uint32_t pair = (0xD7C0 + (code >> 10)) bitor (0xDC00 bitor (code bitand 0x3FF)) << 16;
+	    uint32_t word = code < 0x1'0000 ? code : pair;
+	    std::memcpy(o, &word, sizeof(word));
+	    o += 1 + (code >= 0x1'0000);
+	}
+    }
+
+    for (auto j = b; j < n; j += 32) {
+	if (n - j >= 32)
+	    checker.check(load(ptr + j));
+	else
+	    checker.check_tail(ptr + j, n - j);
+    }
+    if (not checker.valid())
+	return std::nullopt;
+    while (b < n and (ptr[b] bitand 0xC0) == 0x80)
+	++b;
+    auto rest = portable::utf8_to_utf16(in.subspan(b), std::span<char16_t>(o, end));
+    if (not rest)
+	return std::nullopt;
+    return (o - out.data()) + *rest;
+}
+
+// Blocks of 16 ASCII units are narrowed with one pack; blocks without
+// surrogates are encoded branch-free; blocks with surrogates fall back
+// to the checked decoder so pairs are validated.
+std::optional<size_t> utf16_to_utf8(std::span<const char16_t> in, std::span<uint8_t> out) {
+    const auto ptr = in.data();
+    const auto n = in.size();
+    auto o = out.data();
+    const auto end = out.data() + out.size();
+
+    size_t i = 0;
+    while (i + 16 <= n) {
+	auto v = _mm256_loadu_si256(reinterpret_cast<const __m256i*>(ptr + i));
+	if (_mm256_testz_si256(v, _mm256_set1_epi16(int16_t(0xFF80))) and end - o >= 16) {
+	    auto bytes = _mm256_permute4x64_epi64(_mm256_packus_epi16(v, v), 0b1000);
+	    _mm_storeu_si128(reinterpret_cast<__m128i*>(o), _mm256_castsi256_si128(bytes));
+	    o += 16;
+	    i += 16;
+	    continue;
+	}
+	// Up to 3 bytes per unit, stored 4 at a time.
+	if (end - o < 16 * 3 + 1)
+	    break;
+	auto surrogates = _mm256_cmpeq_epi16(_mm256_and_si256(v, _mm256_set1_epi16(int16_t(0xF800))),
+					     _mm256_set1_epi16(int16_t(0xD800)));
+	if (_mm256_testz_si256(surrogates, surrogates)) {
+	    bool bad{};
+	    for (auto last = i + 16; i < last; ++i)
+		o += encode_utf8_unchecked(ptr[i], o, bad);
+	    continue;
+	}
+	for (auto last = i + 16; i < last; ) {
+	    char32_t code;
+	    auto units = decode_utf16(ptr + i, n - i, code);
+	    if (units == 0)
+		return std::nullopt;
+	    o += encode_utf8(code, o, end);
+	    i += units;
+	}
+    }
+    auto rest = portable::utf16_to_utf8(in.subspan(i), std::span<uint8_t>(o, end));
+    if (not rest)
+	return std::nullopt;
+    return (o - out.data()) + *rest;
+}
+
+inline size_t popcount(__m256i mask) {
+    return std::popcount(uint32_t(_mm256_movemask_epi8(mask)));
+}
+
+size_t count_codepoints(std::span<const uint8_t> in) {
+    size_t count{}, i = 0;
+    for (; i + 32 <= in.size(); i += 32)
+	count += 32 - popcount(_mm256_cmpgt_epi8(_mm256_set1_epi8(-64), load(in.data() + i)));
+    return count + portable::count_codepoints(in.subspan(i));
+}
+
+size_t utf16_length_from_utf8(std::span<const uint8_t> in) {
+    size_t count{}, i = 0;
+    for (; i + 32 <= in.size(); i += 32) {
+	auto v = load(in.data() + i);
+	auto conts = _mm256_cmpgt_epi8(_mm256_set1_epi8(-64), v);
+	// 0xF0 and above are -16..-1 signed.
+	auto fours = _mm256_cmpgt_epi8(v, _mm256_set1_epi8(-17));
+	fours = _mm256_andnot_si256(_mm256_cmpgt_epi8(v, _mm256_set1_epi8(-1)), fours);
+	count += 32 - popcount(conts) + popcount(fours);
+    }
+    return count + portable::utf16_length_from_utf8(in.subspan(i));
+}
+
+// Each comparison yields -1 where true; the sums are kept in 32-bit
+// lanes and reduced at the end.
+size_t utf8_length_from_utf32(std::span<const char32_t> in) {
+    auto acc = _mm256_setzero_si256();
+    size_t i = 0;
+    for (; i + 8 <= in.size(); i += 8) {
+	auto v = _mm256_loadu_si256(reinterpret_cast<const __m256i*>(in.data() + i));
+	auto two = _mm256_cmpgt_epi32(v, _mm256_set1_epi32(0x7F));
+	auto three = _mm256_cmpgt_epi32(v, _mm256_set1_epi32(0x7FF));
+	auto four = _mm256_cmpgt_epi32(v, _mm256_set1_epi32(0xFFFF));
+	acc = _mm256_sub_epi32(acc, _mm256_add_epi32(_mm256_add_epi32(two, three), four));
+    }
+    alignas(32) uint32_t lanes[8];
+    _mm256_store_si256(reinterpret_cast<__m256i*>(lanes), acc);
+    size_t count = i;
+    for (auto lane : lanes)
+	count += lane;
+    return count + portable::utf8_length_from_utf32(in.subspan(i));
+}
+
+size_t utf8_length_from_utf16(std::span<const char16_t> in) {
+    auto acc = _mm256_setzero_si256();
+    size_t count{}, i = 0;
+    for (; i + 16 <= in.size(); i += 16) {
+	auto v = _mm256_loadu_si256(reinterpret_cast<const __m256i*>(in.data() + i));
+	auto two = _mm256_cmpeq_epi16(_mm256_max_epu16(v, _mm256_set1_epi16(0x80)), v);
+	auto three = _mm256_cmpeq_epi16(_mm256_max_epu16(v, _mm256_set1_epi16(0x800)), v);
+	auto surrogate = _mm256_cmpeq_epi16(_mm256_and_si256(v, _mm256_set1_epi16(int16_t(0xF800))),
+					    _mm256_set1_epi16(int16_t(0xD800)));
+	// Extra bytes per unit (0, 1 or 2), widened to 32-bit lanes by
+	// the multiply-add.
+	auto extra = _mm256_sub_epi16(surrogate, _mm256_add_epi16(two, three));
+	acc = _mm256_add_epi32(acc, _mm256_madd_epi16(extra, _mm256_set1_epi16(1)));
+	count += 16;
+    }
+    alignas(32) uint32_t lanes[8];
+    _mm256_store_si256(reinterpret_cast<__m256i*>(lanes), acc);
+    for (auto lane : lanes)
+	count += lane;
+    return count + portable::utf8_length_from_utf16(in.subspan(i));
+}
+
+} // namespace avx2
+#endif
+
+#if defined(__AVX2__)
+namespace simd = avx2;
+#else
+namespace simd = portable;
+#endif
+
+// True if `in` is well-formed UTF-8.
+inline bool validate_utf8(std::span<const uint8_t> in) {
+    return simd::validate_utf8(in);
+}
+
+// Decode `in` to code points in `out`.
+inline std::optional<size_t> utf8_to_utf32(std::span<const uint8_t> in, std::span<char32_t> out) {
+    return simd::utf8_to_utf32(in, out);
+}
+
+// Encode the code points in `in` to `out`, which needs room for up to
+// four bytes per code point.
+inline std::optional<size_t> utf32_to_utf8(std::span<const char32_t> in, std::span<uint8_t> out) {
+    return simd::utf32_to_utf8(in, out);
+}
+
+// Decode `in` to UTF-16 in `out`, using surrogate pairs above U+FFFF.
+inline std::optional<size_t> utf8_to_utf16(std::span<const uint8_t> in, std::span<char16_t> out) {
+    return simd::utf8_to_utf16(in, out);
+}
+
+// Encode the UTF-16 in `in` to UTF-8; unpaired surrogates are errors.
+inline std::optional<size_t> utf16_to_utf8(std::span<const char16_t> in, std::span<uint8_t> out) {
+    return simd::utf16_to_utf8(in, out);
+}
+
+// Exact output sizes for valid input, so the transcoders above can
+// write into buffers allocated once.
+inline size_t count_codepoints(std::span<const uint8_t> in) {
+    return simd::count_codepoints(in);
+}
+
+inline size_t utf16_length_from_utf8(std::span<const uint8_t> in) {
+    return simd::utf16_length_from_utf8(in);
+}
+
+inline size_t utf8_length_from_utf32(std::span<const char32_t> in) {
+    return simd::utf8_length_from_utf32(in);
+}
+
+inline size_t utf8_length_from_utf16(std::span<const char16_t> in) {
+    return simd::utf8_length_from_utf16(in);
+}
+
+// Decodes UTF-8 that arrives in arbitrary chunks (from a socket or
+// file) to UTF-32 or UTF-16 with fixed memory. A sequence split across
+// chunks is held back (at most 3 bytes) and completed from the next
+// chunk; everything else in a chunk goes through the bulk kernel.
+template<class CharT>
+class Utf8StreamDecoder {
+    static_assert(std::is_same_v<CharT, char32_t> or std::is_same_v<CharT, char16_t>);
+public:
+    // Output space that is always enough for a valid chunk of `nbytes`:
+    // one unit per byte, plus a pair that completing a held-back
+    // sequence can yield from a single new byte. A malformed chunk may
+    // not fit, but then decode() fails without writing past `out`.
+    static constexpr size_t max_output(size_t nbytes) {
+	return nbytes + 2;
+    }
+
+    // Decode `chunk` into `out`, returning the number of units written,
+    // or nullopt once the stream is found to be malformed.
+    std::optional<size_t> decode(std::span<const uint8_t> chunk, std::span<CharT> out) {
+	if (failed_)
+	    return std::nullopt;
+	size_t written{};
+
+	// Complete the sequence held back from the previous chunk.
+	if (npending_ > 0) {
+	    auto need = size_t(utf8_sequence_length(pending_[0])) - npending_;
+	    auto take = std::min(need, chunk.size());
+	    std::copy_n(chunk.begin(), take, pending_ + npending_);
+	    npending_ += take;
+	    chunk = chunk.subspan(take);
+	    if (take < need)
+		return 0;
+
+	    char32_t code;
+	    auto len = decode_utf8(pending_, npending_, code);
+	    npending_ = 0;
+	    if (len == 0)
+		return fail();
+	    if constexpr (std::is_same_v<CharT, char32_t>)
+		out[written++] = code;
+	    else
+		written += encode_utf16(code, out.data(), out.data() + out.size());
+	}
+
+	// Hold back a lead byte in the last three that its chunk cannot
+	// complete, with any continuation bytes after it. Anything else,
+	// including malformed bytes, is left for the kernel to reject.
+	size_t hold{};
+	for (size_t k = 1; k <= std::min<size_t>(3, chunk.size()); ++k) {
+	    auto byte = chunk[chunk.size() - k];
+	    if ((byte bitand 0xC0) == 0x80)
+		continue;
+	    if (size_t(utf8_sequence_length(byte)) > k)
+		hold = k;
+	    break;
+	}
+
+	auto body = chunk.first(chunk.size() - hold);
+	std::optional<size_t> r;
+	if constexpr (std::is_same_v<CharT, char32_t>)
+	    r = utf8_to_utf32(body, out.subspan(written));
+	else
+	    r = utf8_to_utf16(body, out.subspan(written));
+	if (not r)
+	    return fail();
+	std::copy(chunk.end() - hold, chunk.end(), pending_);
+	npending_ = hold;
+	return written + *r;
+    }
+
+    // True if the stream ended cleanly, not in the middle of a sequence.
+    bool finish() const {
+	return not failed_ and npending_ == 0;
+    }
+
+private:
+    std::optional<size_t> fail() {
+	failed_ = true;
+	return std::nullopt;
+    }
+
+    uint8_t pending_[4];
+    size_t npending_{};
+    bool failed_{false};
+};
+
+// Generate about `nbytes` of text: ASCII words, Latin text with
+// accented letters, CJK with ASCII punctuation or emoji between spaces.
+enum class Corpus { Ascii, Latin, Cjk, Emoji };
+
+std::string make_corpus(Corpus kind, size_t nbytes) {
+    std::mt19937_64 rng;
+    auto pick = [&](uint32_t lo, uint32_t hi) { return lo + uint32_t(rng() % (hi - lo + 1)); };
+    std::string str;
+    str.reserve(nbytes + 4);
+    while (str.size() < nbytes) {
+	uint32_t code{};
+	auto r = rng() % 100;
+	switch (kind) {
+	case Corpus::Ascii:
+	    code = r < 15 ? ' ' : pick('a', 'z');
+	    break;
+	case Corpus::Latin:
+	    code = r < 15 ? ' ' : r < 40 ? pick(0xC0, 0xFF) : pick('a', 'z');
+	    break;
+	case Corpus::Cjk:
+	    code = r < 10 ? pick(0x21, 0x2F) : pick(0x4E00, 0x9FFF);
+	    break;
+	case Corpus::Emoji:
+	    code = r < 20 ? ' ' : pick(0x1'F600, 0x1'F64F);
+	    break;
+	}
+	codepoint_to_utf8(code, std::back_inserter(str));
+    }
+    return str;
+}
+
+// Report the throughput of `work` over `nbytes` of UTF-8 in GB/s.
+template<class Work>
+void measure(std::string_view desc, size_t nbytes, size_t reps, Work&& work) {
+    auto ns = core::timer::Timer().run(reps, work).elapsed_per_iteration();
+    cout << "  " << desc << std::string(26 - std::min<size_t>(desc.size(), 25), ' ')
+	 << nbytes / ns << " GB/s" << endl;
+}
+
+// Compare the dispatched kernels with the portable ones on malformed
+// input (runs of 0xF0, random bytes, valid text with bytes flipped)
+// decoded into output buffers of exactly in.size() units, so a kernel
+// that writes past the end shows up under ASan.
+void check_malformed() {
+    std::mt19937_64 rng;
+    std::vector<std::string> cases;
+    for (size_t n : { 35, 40, 64, 100, 1000 })
+	cases.emplace_back(n, '\xF0');
+    for (int i = 0; i < 200; ++i) {
+	std::string str(1 + rng() % 300, '\0');
+	for (auto& c : str)
+	    c = char(rng());
+	cases.push_back(str);
+    }
+    for (int i = 0; i < 200; ++i) {
+	auto str = make_corpus(Corpus(i % 4), 1 + rng() % 300);
+	str[rng() % str.size()] = char(rng());
+	cases.push_back(str);
+    }
+
+    bool ok{true};
+    for (const auto& str : cases) {
+	std::span<const uint8_t> in(reinterpret_cast<const uint8_t*>(str.data()), str.size());
+	std::vector<char16_t> units(in.size()), expected16(in.size());
+	std::vector<char32_t> codes(in.size()), expected32(in.size());
+	auto r16 = utf8_to_utf16(in, units);
+	auto e16 = portable::utf8_to_utf16(in, expected16);
+	auto r32 = utf8_to_utf32(in, codes);
+	auto e32 = portable::utf8_to_utf32(in, expected32);
+	ok = ok and validate_utf8(in) == portable::validate_utf8(in) and r16 == e16 and r32 == e32
+	    and (not r16 or std::equal(units.begin(), units.begin() + *r16, expected16.begin()))
+	    and (not r32 or std::equal(codes.begin(), codes.begin() + *r32, expected32.begin()));
+    }
+    cout << "malformed check: " << (ok ? "ok" : "MISMATCH") << endl;
+}
+
+void bench_utf8(size_t nbytes, size_t reps) {
+    const std::pair<Corpus, const char*> corpora[] = {
+	{ Corpus::Ascii, "ascii" }, { Corpus::Latin, "latin" },
+	{ Corpus::Cjk, "cjk" }, { Corpus::Emoji, "emoji" }
+    };
+    cout << std::dec;
+    for (auto [kind, name] : corpora) {
+	auto text = make_corpus(kind, nbytes);
+	std::span<const uint8_t> in(reinterpret_cast<const uint8_t*>(text.data()), text.size());
+	std::vector<char32_t> codes(in.size());
+	std::vector<uint8_t> bytes(in.size());
+	auto ncodes = *utf8_to_utf32(in, codes);
+	std::span<const char32_t> code_span(codes.data(), ncodes);
+	cout << name << ": " << in.size() << " bytes, " << ncodes << " code points" << endl;
+
+	bool ok = validate_utf8(in) and portable::validate_utf8(in);
+	measure("validate portable", in.size(), reps, [&]() { ok &= portable::validate_utf8(in); });
+	measure("validate", in.size(), reps, [&]() { ok &= validate_utf8(in); });
+
+	measure("to-utf32 per-sequence", in.size(), reps, [&]() {
+	    auto o = codes.begin();
+	    for (auto iter = text.begin(); iter != text.end(); ) {
+		auto len = utf8_sequence_length(*iter);
+		*o++ = utf8_sequence_to_codepoint(iter);
+		iter += len;
+	    }
+	});
+	measure("to-utf32 portable", in.size(), reps, [&]() { ok &= bool(portable::utf8_to_utf32(in, codes)); });
+	measure("to-utf32", in.size(), reps, [&]() { ok &= bool(utf8_to_utf32(in, codes)); });
+
+	measure("to-utf8 back_inserter", in.size(), reps, [&]() {
+	    std::string str;
+	    for (auto code : code_span)
+		codepoint_to_utf8(code, std::back_inserter(str));
+	    ok &= str.size() == in.size();
+	});
+	measure("to-utf8 portable", in.size(), reps, [&]() { ok &= bool(portable::utf32_to_utf8(code_span, bytes)); });
+	measure("to-utf8", in.size(), reps, [&]() { ok &= bool(utf32_to_utf8(code_span, bytes)); });
+	ok &= std::equal(bytes.begin(), bytes.end(), in.begin());
+
+	// Presizing: compute the exact length, allocate once, transcode.
+	measure("to-utf8 presized", in.size(), reps, [&]() {
+	    std::string str(utf8_length_from_utf32(code_span), '\0');
+	    ok &= bool(utf32_to_utf8(code_span, std::span(reinterpret_cast<uint8_t*>(str.data()), str.size())));
+	});
+
+	std::vector<char16_t> units(utf16_length_from_utf8(in));
+	std::span<const char16_t> unit_span(units);
+	measure("to-utf16 portable", in.size(), reps, [&]() { ok &= bool(portable::utf8_to_utf16(in, units)); });
+	measure("to-utf16", in.size(), reps, [&]() { ok &= utf8_to_utf16(in, units) == units.size(); });
+	measure("from-utf16 portable", in.size(), reps, [&]() { ok &= bool(portable::utf16_to_utf8(unit_span, bytes)); });
+	measure("from-utf16", in.size(), reps, [&]() { ok &= utf16_to_utf8(unit_span, bytes) == in.size(); });
+	ok &= std::equal(bytes.begin(), bytes.end(), in.begin());
+
+	size_t count{};
+	measure("count_codepoints", in.size(), reps, [&]() { count += count_codepoints(in); });
+	measure("utf16_length_from_utf8", in.size(), reps, [&]() { count += utf16_length_from_utf8(in); });
+	measure("utf8_length_from_utf32", in.size(), reps, [&]() { count += utf8_length_from_utf32(code_span); });
+	measure("utf8_length_from_utf16", in.size(), reps, [&]() { count += utf8_length_from_utf16(unit_span); });
+	ok &= count == reps * (ncodes + units.size() + 2 * in.size());
+
+	if (not ok)
+	    cout << "  MISMATCH" << endl;
+    }
+}
+
+// Feed `text` to the streaming decoder in random chunk sizes and check
+// the result against decoding it in one call.
+void check_stream(const std::string& text) {
+    std::span<const uint8_t> in(reinterpret_cast<const uint8_t*>(text.data()), text.size());
+    std::vector<char16_t> expected(utf16_length_from_utf8(in)), units;
+    utf8_to_utf16(in, expected);
+
+    std::mt19937_64 rng;
+    Utf8StreamDecoder<char16_t> decoder;
+    std::vector<char16_t> buffer;
+    for (size_t i = 0; i < in.size(); ) {
+	auto n = std::min<size_t>(1 + rng() % 64, in.size() - i);
+	buffer.resize(decoder.max_output(n));
+	auto r = decoder.decode(in.subspan(i, n), buffer);
+	if (not r)
+	    break;
+	units.insert(units.end(), buffer.begin(), buffer.begin() + *r);
+	i += n;
+    }
+    bool ok = decoder.finish() and units == expected;
+
+    // A sequence cut short at the end of the stream is an error.
+    Utf8StreamDecoder<char16_t> truncated;
+    buffer.resize(truncated.max_output(2));
+    truncated.decode(std::span<const uint8_t>(reinterpret_cast<const uint8_t*>("\xE2\x82"), 2), buffer);
+    ok = ok and not truncated.finish();
+
+    // A malformed chunk fails without writing past the buffer.
+    Utf8StreamDecoder<char16_t> malformed;
+    std::vector<uint8_t> bad(40, 0xF0);
+    buffer.resize(malformed.max_output(bad.size()));
+    ok = ok and not malformed.decode(bad, buffer) and not malformed.finish();
+    cout << "stream check: " << (ok ? "ok" : "MISMATCH") << endl;
+}
+
+// Transcode a file (or `nbytes` of generated text) to UTF-16 through
+// fixed chunk and output buffers.
+void bench_stream(const char *path, size_t nbytes, size_t chunk_bytes) {
+    std::string text;
+    std::FILE *file = nullptr;
+    cout << std::dec;
+    if (path) {
+	file = std::fopen(path, "rb");
+	if (not file) {
+	    cout << "cannot open " << path << endl;
+	    return;
+	}
+    } else {
+	for (auto kind : { Corpus::Ascii, Corpus::Latin, Corpus::Cjk, Corpus::Emoji })
+	    text += make_corpus(kind, nbytes / 4);
+	check_stream(text.substr(0, 1 << 16));
+    }
+
+    Utf8StreamDecoder<char16_t> decoder;
+    std::vector<uint8_t> chunk(chunk_bytes);
+    std::vector<char16_t> units(decoder.max_output(chunk_bytes));
+    size_t total_bytes{}, total_units{};
+    bool ok{true};
+    auto ns = core::timer::Timer().run(1, [&]() {
+	while (ok) {
+	    size_t n;
+	    if (file) {
+		n = std::fread(chunk.data(), 1, chunk.size(), file);
+	    } else {
+		n = std::min(chunk.size(), text.size() - total_bytes);
+		std::memcpy(chunk.data(), text.data() + total_bytes, n);
+	    }
+	    if (n == 0)
+		break;
+	    auto r = decoder.decode(std::span(chunk.data(), n), units);
+	    ok = bool(r);
+	    total_units += r.value_or(0);
+	    total_bytes += n;
+	}
+    }).elapsed_per_iteration();
+    if (file)
+	std::fclose(file);
+
+    cout << "stream: " << total_bytes << " bytes -> " << total_units << " UTF-16 units in "
+	 << chunk_bytes << " byte chunks, " << total_bytes / ns << " GB/s"
+	 << (ok and decoder.finish() ? "" : " (malformed input)") << endl;
+}
+
 void examine(uint32_t code) {
     std::string str;
     codepoint_to_utf8(code, std::back_inserter(str));
@@ -70,5 +1176,19 @@ int main(int argc, const char *argv[]) {
     examine(0x20AC);
     examine(0xD55C);
     examine(0x1'0348);
+
+    // p0 stream [file [chunk-kb]]: chunked transcoding with fixed memory.
+    if (argc > 1 and std::string_view(argv[1]) == "stream") {
+	const char *path = argc > 2 and std::string_view(argv[2]) != "-" ? argv[2] : nullptr;
+	size_t chunk_kb = argc > 3 ? std::stoul(argv[3]) : 64;
+	bench_stream(path, 64 << 20, chunk_kb << 10);
+	return 0;
+    }
+
+    // p0 [megabytes [repetitions]]: bulk UTF-8 throughput per corpus.
+    size_t mb = argc > 1 ? std::stoul(argv[1]) : 4;
+    size_t reps = argc > 2 ? std::stoul(argv[2]) : 20;
+    check_malformed();
+    bench_utf8(mb << 20, reps);
     return 0;
 }
@@ -1,9 +1,20 @@
 // Copyright (C) 2022, 2023 by Mark Melton
 //
 
+#include <algorithm>
+#include <atomic>
+#include <cstring>
 #include <iostream>
+#include <numeric>
+#include <random>
+#include <span>
 #include <vector>
 #include <string>
+#include <thread>
+#include <type_traits>
+#ifdef __AVX2__
+#include <immintrin.h>
+#endif
 #include "core/timer/timer.h"
 
 using std::cout, std::endl;
@@ -48,19 +59,416 @@ void Vec2DFiller(Vec2i &dest, Vec2i src, int dest_x, int dest_y) {
     }
 }
 
+// The rectangle actually copied when a src_w x src_h source is placed
+// with its origin at (dest_x, dest_y) on a dst_w x dst_h destination.
+// Offsets may be negative or put the source partly or wholly outside.
+struct BlitRect {
+    int src_x, src_y, dst_x, dst_y, width, height;
+
+    bool empty() const {
+	return width <= 0 or height <= 0;
+    }
+};
+
+inline BlitRect clip_blit(int src_w, int src_h, int dst_w, int dst_h, int dest_x, int dest_y) {
+    int x0 = std::max(dest_x, 0), y0 = std::max(dest_y, 0);
+    int x1 = std::min(dest_x + src_w, dst_w), y1 = std::min(dest_y + src_h, dst_h);
+    return BlitRect{ x0 - dest_x, y0 - dest_y, x0, y0, x1 - x0, y1 - y0 };
+}
+
+// Copies whole rows of the clipped rectangle, so negative offsets and
+// sources hanging over any edge are handled like Vec2DFiller.
 void Vec2DFiller2(Vec2i &dest, const Vec2i& src, int dest_x, int dest_y) {
-    int ylen = std::min(src.size(), dest.size() > dest_y ? dest.size() - dest_y : 0);
-    if (ylen == 0)
+    if (src.empty() or dest.empty())
         return;
-    
-    int xlen = std::min(src.at(0).size(), dest.at(0).size() - dest_x);
-    if (xlen == 0)
+
+    auto r = clip_blit(src[0].size(), src.size(), dest[0].size(), dest.size(), dest_x, dest_y);
+    if (r.empty())
         return;
 
-    for (auto ydx = 0; ydx < ylen; ++ydx) {
-        auto& ydest = dest.at(ydx + dest_y);
-        const auto& ysrc = src.at(ydx);
-        std::copy(ysrc.data(), ysrc.data() + xlen, ydest.data() + dest_x);
+    for (auto ydx = 0; ydx < r.height; ++ydx) {
+        auto& ydest = dest[r.dst_y + ydx];
+        const auto& ysrc = src[r.src_y + ydx];
+        std::copy_n(ysrc.data() + r.src_x, r.width, ydest.data() + r.dst_x);
+    }
+}
+
+// A width x height grid of T stored row-major in a single allocation.
+// Rows are `stride` elements apart so views of sub-rectangles can share
+// the storage.
+template<class T>
+class GridView {
+public:
+    GridView() = default;
+
+    GridView(T *data, int width, int height, ptrdiff_t stride)
+	: data_(data)
+	, width_(width)
+	, height_(height)
+	, stride_(stride) {
+    }
+
+    // A view of a grid of non-const elements is also a read-only view.
+    operator GridView<const T>() const {
+	return GridView<const T>(data_, width_, height_, stride_);
+    }
+
+    int width() const { return width_; }
+    int height() const { return height_; }
+    ptrdiff_t stride() const { return stride_; }
+    bool empty() const { return width_ <= 0 or height_ <= 0; }
+
+    T *row(int y) const {
+	return data_ + y * stride_;
+    }
+
+    T& operator()(int x, int y) const {
+	return row(y)[x];
+    }
+
+    // The part of the rectangle (x, y, w, h) that lies inside this view.
+    GridView sub(int x, int y, int w, int h) const {
+	int x0 = std::clamp(x, 0, width_), y0 = std::clamp(y, 0, height_);
+	int x1 = std::clamp(x + w, x0, width_), y1 = std::clamp(y + h, y0, height_);
+	return GridView(data_ + y0 * stride_ + x0, x1 - x0, y1 - y0, stride_);
+    }
+
+private:
+    T *data_{};
+    int width_{}, height_{};
+    ptrdiff_t stride_{};
+};
+
+// Allocates with the given alignment, so grid rows can start on cache
+// lines.
+template<class T, size_t Align>
+struct AlignedAllocator {
+    using value_type = T;
+
+    template<class U>
+    struct rebind { using other = AlignedAllocator<U, Align>; };
+
+    AlignedAllocator() = default;
+
+    template<class U>
+    AlignedAllocator(const AlignedAllocator<U, Align>&) {
+    }
+
+    T *allocate(size_t n) {
+	return static_cast<T*>(::operator new(n * sizeof(T), std::align_val_t(Align)));
+    }
+
+    void deallocate(T *ptr, size_t) {
+	::operator delete(ptr, std::align_val_t(Align));
+    }
+
+    bool operator==(const AlignedAllocator&) const = default;
+};
+
+constexpr size_t CacheLine = 64;
+
+// The storage is cache-line aligned and, when T divides a cache line,
+// each row is padded to a whole number of cache lines, so views whose
+// x range starts and ends on a multiple of CacheLine / sizeof(T) never
+// share a cache line with their neighbors.
+template<class T>
+class Grid {
+public:
+    Grid() = default;
+
+    Grid(int width, int height, const T& value = T{})
+	: width_(width)
+	, height_(height)
+	, stride_(padded_stride(width)) {
+	data_.assign(size_t(stride_) * height, value);
+    }
+
+    // Build from nested vectors, e.g. for comparison with Vec2i.
+    explicit Grid(const std::vector<std::vector<T>>& rows)
+	: Grid(rows.empty() ? 0 : rows[0].size(), rows.size()) {
+	for (int y = 0; y < height_; ++y)
+	    std::copy(rows[y].begin(), rows[y].end(), row(y));
+    }
+
+    int width() const { return width_; }
+    int height() const { return height_; }
+
+    T *row(int y) { return data_.data() + size_t(y) * stride_; }
+    const T *row(int y) const { return data_.data() + size_t(y) * stride_; }
+
+    T& operator()(int x, int y) { return row(y)[x]; }
+    const T& operator()(int x, int y) const { return row(y)[x]; }
+
+    GridView<T> view() {
+	return GridView<T>(data_.data(), width_, height_, stride_);
+    }
+
+    GridView<const T> view() const {
+	return GridView<const T>(data_.data(), width_, height_, stride_);
+    }
+
+    GridView<T> sub(int x, int y, int w, int h) {
+	return view().sub(x, y, w, h);
+    }
+
+    GridView<const T> sub(int x, int y, int w, int h) const {
+	return view().sub(x, y, w, h);
+    }
+
+    // Grids are equal if their elements are; row padding is ignored.
+    bool operator==(const Grid& other) const {
+	if (width_ != other.width_ or height_ != other.height_)
+	    return false;
+	for (int y = 0; y < height_; ++y)
+	    if (not std::equal(row(y), row(y) + width_, other.row(y)))
+		return false;
+	return true;
+    }
+
+private:
+    static int padded_stride(int width) {
+	if constexpr (CacheLine % sizeof(T) == 0) {
+	    constexpr int per_line = CacheLine / sizeof(T);
+	    return (width + per_line - 1) / per_line * per_line;
+	} else {
+	    return width;
+	}
+    }
+
+    std::vector<T, AlignedAllocator<T, CacheLine>> data_;
+    int width_{}, height_{};
+    ptrdiff_t stride_{};
+};
+
+// How a source element combines with the destination element under
+// it. Masked copies every source element except `transparent`, as
+// for sprites.
+enum class Blend { Copy, Add, Max, Masked };
+
+// Blend one row of `n` elements. 32-bit integers use AVX2 when
+// available; Add wraps around for integers.
+template<Blend Mode, class T>
+void blend_row(T *dst, const T *src, int n, T transparent) {
+    if constexpr (Mode == Blend::Copy) {
+	std::copy_n(src, n, dst);
+	return;
+    }
+    int i = 0;
+#ifdef __AVX2__
+    if constexpr (std::is_integral_v<T> and sizeof(T) == 4) {
+	const auto key = _mm256_set1_epi32(transparent);
+	for (; i + 8 <= n; i += 8) {
+	    auto s = _mm256_loadu_si256(reinterpret_cast<const __m256i*>(src + i));
+	    auto d = _mm256_loadu_si256(reinterpret_cast<const __m256i*>(dst + i));
+	    if constexpr (Mode == Blend::Add)
+		d = _mm256_add_epi32(d, s);
+	    else if constexpr (Mode == Blend::Max)
+		d = std::is_signed_v<T> ? _mm256_max_epi32(d, s) : _mm256_max_epu32(d, s);
+	    else
+		d = _mm256_blendv_epi8(s, d, _mm256_cmpeq_epi32(s, key));
+	    _mm256_storeu_si256(reinterpret_cast<__m256i*>(dst + i), d);
+	}
+    }
+#endif
+    for (; i < n; ++i) {
+	if constexpr (Mode == Blend::Add) {
+	    if constexpr (std::is_integral_v<T>) {
+		using U = std::make_unsigned_t<T>;
+		dst[i] = T(U(dst[i]) + U(src[i]));
+	    } else {
+		dst[i] += src[i];
+	    }
+	} else if constexpr (Mode == Blend::Max) {
+	    dst[i] = std::max(dst[i], src[i]);
+	} else {
+	    if (src[i] != transparent)
+		dst[i] = src[i];
+	}
+    }
+}
+
+template<Blend Mode, class T>
+void blit_rows(GridView<T> dst, GridView<const T> src, const BlitRect& r, T transparent) {
+    for (int y = 0; y < r.height; ++y)
+	blend_row<Mode>(dst.row(r.dst_y + y) + r.dst_x, src.row(r.src_y + y) + r.src_x, r.width,
+			transparent);
+}
+
+// Blend `src` onto `dst` at (dest_x, dest_y), which may be negative or
+// leave the source partly outside. The clipping is computed once and
+// the mode dispatched once; each row is then one kernel call.
+template<class T>
+void blit(GridView<T> dst, GridView<const std::type_identity_t<T>> src, int dest_x, int dest_y,
+	  Blend mode = Blend::Copy, std::type_identity_t<T> transparent = T{}) {
+    auto r = clip_blit(src.width(), src.height(), dst.width(), dst.height(), dest_x, dest_y);
+    if (r.empty())
+	return;
+    switch (mode) {
+    case Blend::Copy: blit_rows<Blend::Copy>(dst, src, r, transparent); break;
+    case Blend::Add: blit_rows<Blend::Add>(dst, src, r, transparent); break;
+    case Blend::Max: blit_rows<Blend::Max>(dst, src, r, transparent); break;
+    case Blend::Masked: blit_rows<Blend::Masked>(dst, src, r, transparent); break;
+    }
+}
+
+template<class T>
+void GridPrinter(GridView<T> grid) {
+    for (int y = 0; y < grid.height(); ++y) {
+	for (int x = 0; x < grid.width(); ++x)
+	    cout << grid(x, y);
+	cout << endl;
+    }
+}
+
+// Blit a 4K source onto a 4K destination, offset up and to the left so
+// it is clipped on two sides, in each mode; compare with the Vec2i
+// fillers for the plain copy.
+void bench_blit() {
+    constexpr int Width = 3840, Height = 2160;
+    constexpr int DestX = -64, DestY = -32;
+    Grid<int> dst(Width, Height, 1), src(Width, Height);
+    for (int y = 0; y < Height; ++y)
+	for (int x = 0; x < Width; ++x)
+	    src(x, y) = (x * 7 + y * 13) % 5;
+
+    auto r = clip_blit(Width, Height, Width, Height, DestX, DestY);
+    double pixels = double(r.width) * r.height;
+    auto report = [&](const char *desc, double ns) {
+	cout << "  " << desc << std::string(20 - std::min<size_t>(std::strlen(desc), 19), ' ')
+	     << ns / 1e6 << " ms " << pixels / ns << " Gpixel/s" << endl;
+    };
+
+    cout << "\n4K blit at (" << DestX << ", " << DestY << "):" << endl;
+    Vec2i vdst(Height, std::vector<int>(Width, 1)), vsrc(Height, std::vector<int>(Width));
+    for (int y = 0; y < Height; ++y)
+	std::copy_n(src.row(y), Width, vsrc[y].data());
+    report("Vec2DFiller", core::timer::Timer().run(3, [&]() {
+	Vec2DFiller(vdst, vsrc, DestX, DestY);
+    }).elapsed_per_iteration());
+    report("Vec2DFiller2", core::timer::Timer().run(20, [&]() {
+	Vec2DFiller2(vdst, vsrc, DestX, DestY);
+    }).elapsed_per_iteration());
+
+    const std::pair<Blend, const char*> modes[] = {
+	{ Blend::Copy, "blit copy" }, { Blend::Add, "blit add" },
+	{ Blend::Max, "blit max" }, { Blend::Masked, "blit masked" }
+    };
+    for (auto [mode, desc] : modes) {
+	report(desc, core::timer::Timer().run(20, [&]() {
+	    blit(dst.view(), src.view(), DestX, DestY, mode, 0);
+	}).elapsed_per_iteration());
+    }
+
+    blit(dst.view(), src.view(), DestX, DestY);
+    cout << "  copy matches Vec2DFiller: " << std::boolalpha << (dst == Grid<int>(vdst)) << endl;
+}
+
+// A source placed on the destination by the compositor.
+template<class T>
+struct Layer {
+    GridView<const T> src;
+    int x, y;
+    Blend mode{Blend::Copy};
+    T transparent{};
+};
+
+// Blend `layers`, in order, onto `dst` using `nthreads` threads. The
+// destination is cut into tile_w x tile_h tiles (128 KB by default, so
+// a tile stays in L2) and each layer is binned into the tiles its
+// clipped rectangle touches. Threads then claim whole tiles and apply
+// their bins in layer order, so each destination element sees the same
+// sequence of blends as applying the layers one after another. If `dst`
+// starts on a cache line and tile_w is a multiple of CacheLine /
+// sizeof(T), no two threads write the same cache line.
+template<class T>
+void composite(GridView<T> dst, std::span<const Layer<T>> layers, int nthreads,
+	       int tile_w = 1024 / sizeof(T), int tile_h = 128) {
+    const int tiles_x = (dst.width() + tile_w - 1) / tile_w;
+    const int tiles_y = (dst.height() + tile_h - 1) / tile_h;
+    const size_t ntiles = size_t(tiles_x) * tiles_y;
+
+    // Bin the layers with a counting pass and a fill pass, so each
+    // tile's list is contiguous and in layer order.
+    auto for_each_tile = [&](const Layer<T>& layer, auto&& fn) {
+	auto r = clip_blit(layer.src.width(), layer.src.height(), dst.width(), dst.height(),
+			   layer.x, layer.y);
+	if (r.empty())
+	    return;
+	for (int ty = r.dst_y / tile_h; ty <= (r.dst_y + r.height - 1) / tile_h; ++ty)
+	    for (int tx = r.dst_x / tile_w; tx <= (r.dst_x + r.width - 1) / tile_w; ++tx)
+		fn(size_t(ty) * tiles_x + tx);
+    };
+    std::vector<uint32_t> offsets(ntiles + 1), bins;
+    for (const auto& layer : layers)
+	for_each_tile(layer, [&](size_t t) { ++offsets[t + 1]; });
+    std::partial_sum(offsets.begin(), offsets.end(), offsets.begin());
+    bins.resize(offsets.back());
+    {
+	auto fill = offsets;
+	for (uint32_t l = 0; l < layers.size(); ++l)
+	    for_each_tile(layers[l], [&](size_t t) { bins[fill[t]++] = l; });
+    }
+
+    std::atomic<size_t> next{0};
+    auto worker = [&]() {
+	for (size_t t; (t = next++) < ntiles; ) {
+	    int x0 = int(t % tiles_x) * tile_w, y0 = int(t / tiles_x) * tile_h;
+	    auto tile = dst.sub(x0, y0, tile_w, tile_h);
+	    for (auto i = offsets[t]; i < offsets[t + 1]; ++i) {
+		const auto& layer = layers[bins[i]];
+		blit(tile, layer.src, layer.x - x0, layer.y - y0, layer.mode, layer.transparent);
+	    }
+	}
+    };
+    std::vector<std::thread> threads;
+    for (int i = 1; i < nthreads; ++i)
+	threads.emplace_back(worker);
+    worker();
+    for (auto& thread : threads)
+	thread.join();
+}
+
+// Composite 500 sprites and heat blobs of 32..512 pixels onto a 4K
+// destination, one layer at a time and tiled with 1..N threads.
+void bench_composite() {
+    constexpr int Width = 3840, Height = 2160, NumLayers = 500, NumSources = 16;
+    std::mt19937_64 rng;
+    std::uniform_int_distribution<int> size(32, 512);
+
+    std::vector<Grid<int>> sources;
+    for (int i = 0; i < NumSources; ++i) {
+	Grid<int> src(size(rng), size(rng));
+	for (int y = 0; y < src.height(); ++y)
+	    for (int x = 0; x < src.width(); ++x)
+		src(x, y) = int(rng() % 4);
+	sources.push_back(std::move(src));
+    }
+
+    const Blend modes[] = { Blend::Masked, Blend::Add, Blend::Max, Blend::Copy };
+    std::vector<Layer<int>> layers;
+    for (int i = 0; i < NumLayers; ++i) {
+	const auto& src = sources[rng() % NumSources];
+	int x = int(rng() % (Width + src.width())) - src.width() / 2;
+	int y = int(rng() % (Height + src.height())) - src.height() / 2;
+	layers.push_back(Layer<int>{ src.view(), x, y, modes[rng() % 4], 0 });
+    }
+
+    cout << "\nComposite " << NumLayers << " layers onto " << Width << "x" << Height << ":" << endl;
+    Grid<int> expected(Width, Height);
+    auto ns = core::timer::Timer().run(5, [&]() {
+	for (const auto& layer : layers)
+	    blit(expected.view(), layer.src, layer.x, layer.y, layer.mode, layer.transparent);
+    }).elapsed_per_iteration();
+    cout << "  layer by layer      " << ns / 1e6 << " ms" << endl;
+
+    int max_threads = std::max(1u, std::thread::hardware_concurrency());
+    for (int nthreads = 1; nthreads <= max_threads; nthreads *= 2) {
+	Grid<int> dst(Width, Height);
+	ns = core::timer::Timer().run(5, [&]() {
+	    composite<int>(dst.view(), layers, nthreads);
+	}).elapsed_per_iteration();
+	cout << "  tiled " << nthreads << " thread(s)" << std::string(nthreads < 10 ? 4 : 3, ' ')
+	     << ns / 1e6 << " ms" << (dst == expected ? "" : " MISMATCH") << endl;
     }
 }
 
@@ -109,9 +517,27 @@ int main(void)
 	Vec2DFiller2(dest, src, dest_x, dest_y);
     }).elapsed_per_iteration();
     cout << ns << " ns / op" << endl;
+
+    // The same fill with one allocation per grid and clipping done once.
+    Grid<int> grid_dest(10, 10), grid_src(src);
+    ns = core::timer::Timer().run(1'000'000, [&]() {
+	blit(grid_dest.view(), grid_src.view(), dest_x, dest_y);
+    }).elapsed_per_iteration();
+    cout << ns << " ns / op (Grid)" << endl;
     
     std::cout << "\nDestination contents (after change):" << std::endl;
     Vec2DPrinter(dest);
+    cout << "Grid matches: " << std::boolalpha << (grid_dest == Grid<int>(dest)) << endl;
+
+    // A negative offset clips the top and left of the source.
+    Grid<int> sprite(5, 5, 2);
+    sprite(2, 2) = 0;
+    blit(grid_dest.view(), sprite.view(), -2, -1, Blend::Masked, 0);
+    cout << "\nMasked blit at (-2, -1):" << endl;
+    GridPrinter(grid_dest.view());
+
+    bench_blit();
+    bench_composite();
 
     return 0;
 }
@@ -1,11 +1,738 @@
 // Copyright (C) 2022, 2023 by Mark Melton
 //
 
+#include <algorithm>
+#include <chrono>
+#include <cmath>
+#include <cstring>
+#include <cstdio>
 #include <iostream>
+#include <limits>
+#include <memory>
+#include <numeric>
 #include <random>
+#include <stdexcept>
+#include <string_view>
+#include <thread>
+#include <vector>
 
 using std::cout, std::endl;
 
+// A buffer of `nrecords` fixed-width records of `nbytes` each, where
+// the width is only known at run-time.
+struct Records {
+    uint8_t *data;
+    size_t nrecords, nbytes;
+
+    uint8_t *operator[](size_t idx) const {
+	return data + idx * nbytes;
+    }
+};
+
+// Read the (possibly unaligned) int key of a record.
+inline int32_t load_key(const uint8_t *record, size_t key_index) {
+    int32_t key;
+    std::memcpy(&key, record + key_index, sizeof(key));
+    return key;
+}
+
+// Keys and record indices are packed into one 64-bit word: the key
+// (sign bit flipped so unsigned order matches signed order) in the
+// high half and the original index in the low half. Sorting the words
+// sorts by key and, among equal keys, by original position, so the
+// result is stable.
+using KeyIndex = uint64_t;
+
+inline KeyIndex make_key_index(int32_t key, uint32_t idx) {
+    auto ukey = static_cast<uint32_t>(key) ^ 0x8000'0000u;
+    return (uint64_t{ukey} << 32) bitor idx;
+}
+
+inline uint32_t index_of(KeyIndex ki) {
+    return static_cast<uint32_t>(ki);
+}
+
+// Extract the keys once, in a single sequential pass over the records.
+std::vector<KeyIndex> extract_keys(const Records& recs, size_t key_index) {
+    if (recs.nrecords > std::numeric_limits<uint32_t>::max())
+	throw std::length_error("extract_keys: more than 2^32 - 1 records");
+    std::vector<KeyIndex> keys(recs.nrecords);
+    for (size_t i = 0; i < recs.nrecords; ++i)
+	keys[i] = make_key_index(load_key(recs[i], key_index), i);
+    return keys;
+}
+
+// Stable LSD radix sort of the packed words by their 32-bit key, 8
+// bits per pass. `tmp` must be the same size as `keys`.
+void radix_sort_keys(std::vector<KeyIndex>& keys, std::vector<KeyIndex>& tmp) {
+    constexpr int Bits = 8, Buckets = 1 << Bits;
+    for (int shift = 32; shift < 64; shift += Bits) {
+	size_t count[Buckets + 1] = {};
+	for (auto k : keys)
+	    ++count[((k >> shift) bitand (Buckets - 1)) + 1];
+
+	// Skip passes where every key has the same digit.
+	if (std::any_of(count + 1, count + Buckets + 1, [&](size_t c) { return c == keys.size(); }))
+	    continue;
+
+	std::partial_sum(count, count + Buckets + 1, count);
+	for (auto k : keys)
+	    tmp[count[(k >> shift) bitand (Buckets - 1)]++] = k;
+	keys.swap(tmp);
+    }
+}
+
+// Rearrange the records in place so that position `i` receives the
+// record originally at `index_of(order[i])`. Each permutation cycle is
+// followed once, moving every record exactly once through a single
+// record-sized temporary. `order` is consumed.
+void permute_in_place(const Records& recs, std::vector<KeyIndex>& order) {
+    std::vector<uint8_t> tmp(recs.nbytes);
+    constexpr KeyIndex Done = ~KeyIndex{0};
+    for (size_t i = 0; i < recs.nrecords; ++i) {
+	if (order[i] == Done)
+	    continue;
+	if (index_of(order[i]) == i) {
+	    order[i] = Done;
+	    continue;
+	}
+
+	std::memcpy(tmp.data(), recs[i], recs.nbytes);
+	size_t j = i;
+	while (true) {
+	    size_t src = index_of(order[j]);
+	    order[j] = Done;
+	    if (src == i) {
+		std::memcpy(recs[j], tmp.data(), recs.nbytes);
+		break;
+	    }
+	    std::memcpy(recs[j], recs[src], recs.nbytes);
+	    j = src;
+	}
+    }
+}
+
+enum class KeySort { Comparison, Radix };
+
+// Sort the records by the int at `key_index`: extract (key, index)
+// pairs, sort them, then permute the records in place.
+void sort_records(const Records& recs, size_t key_index, KeySort method = KeySort::Radix) {
+    auto keys = extract_keys(recs, key_index);
+    if (method == KeySort::Radix) {
+	std::vector<KeyIndex> tmp(keys.size());
+	radix_sort_keys(keys, tmp);
+    } else {
+	std::sort(keys.begin(), keys.end());
+    }
+    permute_in_place(recs, keys);
+}
+
+bool is_sorted_records(const Records& recs, size_t key_index) {
+    for (size_t i = 1; i < recs.nrecords; ++i)
+	if (load_key(recs[i], key_index) < load_key(recs[i - 1], key_index))
+	    return false;
+    return true;
+}
+
+// Millisecond wall-clock timing of a phase.
+template<class Work>
+auto measure(Work&& work) {
+    auto start = std::chrono::steady_clock::now();
+    work();
+    auto elapsed = std::chrono::steady_clock::now() - start;
+    return std::chrono::duration_cast<std::chrono::milliseconds>(elapsed).count();
+}
+
+// Tournament (loser) tree over `k` sources for a k-way merge. Each
+// internal node keeps the loser of the match played there, so
+// replacing the winner's value replays only the matches on its path to
+// the root: log2(k) comparisons per record and no re-heapification.
+// Values are 64-bit words compared as unsigned integers.
+class LoserTree {
+public:
+    explicit LoserTree(size_t k)
+	: k_(k)
+	, tree_(k)
+	, values_(k + 1) {
+    }
+
+    // Set every leaf value and build the tree.
+    void build(const std::vector<uint64_t>& values) {
+	std::copy(values.begin(), values.end(), values_.begin());
+	// Leaf k is a sentinel that beats everything; it is pushed out of
+	// the tree as the real leaves are played in.
+	std::fill(tree_.begin(), tree_.end(), k_);
+	for (size_t i = k_; i-- > 0; )
+	    replay(i);
+    }
+
+    size_t winner() const {
+	return tree_[0];
+    }
+
+    uint64_t value(size_t leaf) const {
+	return values_[leaf];
+    }
+
+    // Update the value of leaf `s` (normally the winner) and replay.
+    void update(size_t s, uint64_t value) {
+	values_[s] = value;
+	replay(s);
+    }
+
+private:
+    bool beats(size_t a, size_t b) const {
+	if (a == k_) return true;
+	if (b == k_) return false;
+	return values_[a] < values_[b];
+    }
+
+    void replay(size_t s) {
+	for (size_t t = (s + k_) / 2; t > 0; t /= 2)
+	    if (beats(tree_[t], s))
+		std::swap(s, tree_[t]);
+	tree_[0] = s;
+    }
+
+    size_t k_;
+    std::vector<size_t> tree_;
+    std::vector<uint64_t> values_;
+};
+
+// Sequential record input from a file through a large buffer.
+class RunReader {
+public:
+    RunReader(std::FILE *file, size_t nbytes, size_t buffer_bytes)
+	: file_(file)
+	, nbytes_(nbytes)
+	, buffer_(std::max(nbytes, buffer_bytes / nbytes * nbytes)) {
+	std::rewind(file_);
+    }
+
+    // The current record, or nullptr when the run is exhausted.
+    const uint8_t *current() {
+	if (pos_ == end_) {
+	    end_ = std::fread(buffer_.data(), 1, buffer_.size(), file_) / nbytes_ * nbytes_;
+	    pos_ = 0;
+	    if (end_ == 0)
+		return nullptr;
+	}
+	return buffer_.data() + pos_;
+    }
+
+    void advance() {
+	pos_ += nbytes_;
+    }
+
+private:
+    std::FILE *file_;
+    size_t nbytes_;
+    std::vector<uint8_t> buffer_;
+    size_t pos_{}, end_{};
+};
+
+// Sequential record output to a file through a large buffer.
+class RunWriter {
+public:
+    RunWriter(std::FILE *file, size_t buffer_bytes)
+	: file_(file) {
+	buffer_.reserve(buffer_bytes);
+    }
+
+    ~RunWriter() {
+	flush();
+    }
+
+    void write(const uint8_t *data, size_t n) {
+	if (buffer_.size() + n > buffer_.capacity())
+	    flush();
+	if (n >= buffer_.capacity()) {
+	    write_file(data, n);
+	    return;
+	}
+	buffer_.insert(buffer_.end(), data, data + n);
+    }
+
+    void flush() {
+	write_file(buffer_.data(), buffer_.size());
+	buffer_.clear();
+    }
+
+private:
+    void write_file(const uint8_t *data, size_t n) {
+	if (n > 0 and std::fwrite(data, 1, n, file_) != n)
+	    throw std::runtime_error("RunWriter: write failed");
+    }
+
+    std::FILE *file_;
+    std::vector<uint8_t> buffer_;
+};
+
+struct FileCloser {
+    void operator()(std::FILE *f) const { std::fclose(f); }
+};
+using File = std::unique_ptr<std::FILE, FileCloser>;
+
+inline File temp_file() {
+    File f{std::tmpfile()};
+    if (not f)
+	throw std::runtime_error("temp_file: cannot create temporary file");
+    return f;
+}
+
+// Merge the sorted `runs` into `out` with a loser tree keyed on (key,
+// run number), so equal keys keep run order and the merge is stable.
+// Each input and the output get an equal share of `memory` as buffer.
+void merge_runs(std::vector<File>& runs, std::FILE *out, size_t nbytes, size_t key_index,
+		size_t memory) {
+    const size_t k = runs.size();
+    if (k == 0)
+	return;
+    const size_t buffer_bytes = memory / (k + 1);
+    std::vector<RunReader> readers;
+    readers.reserve(k);
+    for (auto& run : runs)
+	readers.emplace_back(run.get(), nbytes, buffer_bytes);
+
+    constexpr uint64_t Exhausted = ~uint64_t{0};
+    auto leaf_value = [&](size_t r) {
+	auto rec = readers[r].current();
+	if (not rec) return Exhausted;
+	auto ukey = static_cast<uint32_t>(load_key(rec, key_index)) ^ 0x8000'0000u;
+	return (uint64_t{ukey} << 32) bitor r;
+    };
+
+    LoserTree tree(k);
+    std::vector<uint64_t> initial(k);
+    for (size_t r = 0; r < k; ++r)
+	initial[r] = leaf_value(r);
+    tree.build(initial);
+
+    RunWriter writer(out, buffer_bytes);
+    while (tree.value(tree.winner()) != Exhausted) {
+	auto r = tree.winner();
+	writer.write(readers[r].current(), nbytes);
+	readers[r].advance();
+	tree.update(r, leaf_value(r));
+    }
+}
+
+struct ExternalSortStats {
+    size_t runs{}, merge_passes{};
+    double run_mb_per_sec{}, merge_mb_per_sec{};
+};
+
+// Sort the fixed-width records in `in` by the int at `key_index` into
+// `out` using at most about `memory` bytes: sort memory-sized runs with
+// `sort_records`, spill them to temporary files and k-way merge them.
+// If there are more runs than the fan-in that keeps each merge buffer
+// at least `min_buffer` bytes, runs are merged in several passes.
+ExternalSortStats external_sort(std::FILE *in, std::FILE *out, size_t nbytes, size_t key_index,
+				size_t memory, size_t min_buffer = 1 << 20) {
+    ExternalSortStats stats;
+    // Each record in a run also needs two 8-byte key words.
+    const size_t run_records = std::max<size_t>(1, memory / (nbytes + 2 * sizeof(KeyIndex)));
+    const size_t max_fanin = std::max<size_t>(2, memory / min_buffer - 1);
+
+    std::vector<File> runs;
+    std::vector<uint8_t> buffer(run_records * nbytes);
+    size_t total_bytes{};
+    auto run_ms = measure([&]() {
+	std::rewind(in);
+	while (true) {
+	    auto n = std::fread(buffer.data(), 1, buffer.size(), in) / nbytes;
+	    if (n == 0)
+		break;
+	    Records recs{buffer.data(), n, nbytes};
+	    sort_records(recs, key_index);
+	    auto run = temp_file();
+	    RunWriter(run.get(), 0).write(buffer.data(), n * nbytes);
+	    runs.push_back(std::move(run));
+	    total_bytes += n * nbytes;
+	}
+    });
+    buffer = {};
+    stats.runs = runs.size();
+    stats.run_mb_per_sec = total_bytes / 1e3 / std::max<double>(run_ms, 1);
+
+    auto merge_ms = measure([&]() {
+	while (runs.size() > max_fanin) {
+	    std::vector<File> merged;
+	    for (size_t first = 0; first < runs.size(); first += max_fanin) {
+		auto last = std::min(runs.size(), first + max_fanin);
+		std::vector<File> group;
+		for (auto i = first; i < last; ++i)
+		    group.push_back(std::move(runs[i]));
+		auto run = temp_file();
+		merge_runs(group, run.get(), nbytes, key_index, memory);
+		std::fflush(run.get());
+		merged.push_back(std::move(run));
+	    }
+	    runs = std::move(merged);
+	    ++stats.merge_passes;
+	}
+	merge_runs(runs, out, nbytes, key_index, memory);
+	std::fflush(out);
+	++stats.merge_passes;
+    });
+    stats.merge_mb_per_sec = stats.merge_passes * total_bytes / 1e3 / std::max<double>(merge_ms, 1);
+    return stats;
+}
+
+// Generate `nrecords` random records in a temporary file, sort them
+// externally with a `memory_mb` budget and verify the output.
+void bench_external(size_t nrecords, size_t nbytes, size_t key_index, size_t memory_mb) {
+    auto in = temp_file(), out = temp_file();
+    {
+	std::mt19937_64 rng;
+	std::vector<uint8_t> chunk(std::min<size_t>(nrecords * nbytes, 64 << 20));
+	RunWriter writer(in.get(), 0);
+	for (size_t left = nrecords * nbytes; left > 0; ) {
+	    auto n = std::min(left, chunk.size());
+	    for (auto& byte : chunk)
+		byte = rng();
+	    writer.write(chunk.data(), n);
+	    left -= n;
+	}
+    }
+    std::fflush(in.get());
+
+    cout << "external: " << nrecords << " records of " << nbytes << " bytes ("
+	 << nrecords * nbytes / (1 << 20) << " MB) with " << memory_mb << " MB" << endl;
+    auto stats = external_sort(in.get(), out.get(), nbytes, key_index, memory_mb << 20);
+
+    RunReader reader(out.get(), nbytes, 16 << 20);
+    size_t count{};
+    bool sorted{true};
+    int32_t last = std::numeric_limits<int32_t>::min();
+    for (auto rec = reader.current(); rec; reader.advance(), rec = reader.current(), ++count) {
+	auto key = load_key(rec, key_index);
+	sorted = sorted and last <= key;
+	last = key;
+    }
+
+    cout << "  runs " << stats.runs << " at " << stats.run_mb_per_sec << " MB/s, "
+	 << stats.merge_passes << " merge pass(es) at " << stats.merge_mb_per_sec << " MB/s"
+	 << (sorted and count == nrecords ? "" : " NOT SORTED") << endl;
+}
+
+void bench(size_t nrecords, size_t nbytes, size_t key_index) {
+    std::vector<uint8_t> data(nrecords * nbytes), original;
+    std::uniform_int_distribution<uint8_t> d;
+    std::mt19937_64 rng;
+    std::generate(data.begin(), data.end(), [&]() { return d(rng); });
+    original = data;
+    Records recs{data.data(), nrecords, nbytes};
+
+    cout << nrecords << " records of " << nbytes << " bytes ("
+	 << data.size() / (1 << 20) << " MB)" << endl;
+
+    // Baseline: sort an index array comparing keys read from the records.
+    {
+	std::vector<uint32_t> index(nrecords);
+	std::iota(index.begin(), index.end(), 0);
+	auto ms = measure([&]() {
+	    std::stable_sort(index.begin(), index.end(), [&](uint32_t a, uint32_t b) {
+		return load_key(recs[a], key_index) < load_key(recs[b], key_index);
+	    });
+	});
+	cout << "  index-sort (keys read from records): " << ms << " ms" << endl;
+    }
+
+    for (auto method : { KeySort::Comparison, KeySort::Radix }) {
+	data = original;
+	std::vector<KeyIndex> keys, tmp;
+	auto extract_ms = measure([&]() { keys = extract_keys(recs, key_index); });
+	auto sort_ms = measure([&]() {
+	    if (method == KeySort::Radix) {
+		tmp.resize(keys.size());
+		radix_sort_keys(keys, tmp);
+	    } else {
+		std::sort(keys.begin(), keys.end());
+	    }
+	});
+	auto permute_ms = measure([&]() { permute_in_place(recs, keys); });
+
+	cout << (method == KeySort::Radix ? "  radix     " : "  std::sort ")
+	     << " extract " << extract_ms << " ms"
+	     << " sort " << sort_ms << " ms"
+	     << " permute " << permute_ms << " ms"
+	     << " total " << extract_ms + sort_ms + permute_ms << " ms"
+	     << (is_sorted_records(recs, key_index) ? "" : " NOT SORTED") << endl;
+    }
+}
+
+// A field of a composite sort key. Records are little-endian; `Int`
+// and `Uint` fields are 1, 2, 4 or 8 bytes wide, `Float` fields 4 or 8
+// and `Bytes` fields (compared like memcmp) any width.
+enum class KeyType { Int, Uint, Float, Bytes };
+
+struct KeyField {
+    size_t offset, width;
+    KeyType type;
+    bool descending{false};
+};
+
+using KeySpec = std::vector<KeyField>;
+
+inline size_t key_length(const KeySpec& spec) {
+    size_t n{};
+    for (const auto& field : spec)
+	n += field.width;
+    return n;
+}
+
+// Write the key of `record` to `out` (key_length(spec) bytes) in a
+// normalized form whose memcmp order is the key order: numbers are
+// stored big-endian with the sign handled, descending fields inverted.
+// NaNs are not supported.
+void normalize_key(const KeySpec& spec, const uint8_t *record, uint8_t *out) {
+    for (const auto& field : spec) {
+	auto src = record + field.offset;
+	if (field.type == KeyType::Bytes) {
+	    std::memcpy(out, src, field.width);
+	} else {
+	    uint64_t bits{};
+	    std::memcpy(&bits, src, field.width);
+	    const auto sign = uint64_t{1} << (8 * field.width - 1);
+	    const auto mask = field.width == 8 ? ~uint64_t{0} : (uint64_t{1} << 8 * field.width) - 1;
+	    if (field.type == KeyType::Int)
+		bits ^= sign;
+	    else if (field.type == KeyType::Float)
+		// -0.0 compares equal to 0.0, so give it the same bytes.
+		bits = (bits & ~sign) == 0 ? sign : (bits & sign) ? ~bits & mask : bits ^ sign;
+	    for (size_t i = 0; i < field.width; ++i)
+		out[i] = bits >> (8 * (field.width - 1 - i));
+	}
+	if (field.descending)
+	    for (size_t i = 0; i < field.width; ++i)
+		out[i] = ~out[i];
+	out += field.width;
+    }
+}
+
+// The first PrefixBytes of a normalized key held as two big-endian
+// words, so comparing the words as integers is the same as memcmp on
+// the bytes. The record index breaks ties, which makes the sort stable.
+struct PrefixEntry {
+    static constexpr size_t PrefixBytes = 16;
+    uint64_t hi, lo;
+    uint32_t index;
+};
+
+inline uint64_t load_be64(const uint8_t *ptr) {
+    uint64_t word{};
+    for (int i = 0; i < 8; ++i)
+	word = (word << 8) bitor ptr[i];
+    return word;
+}
+
+// Run work(begin, end) over `n` items split into `nthreads` ranges.
+template<class Work>
+void parallel_for(size_t n, size_t nthreads, Work&& work) {
+    std::vector<std::thread> threads;
+    for (size_t t = 0; t < nthreads; ++t)
+	threads.emplace_back([&, t]() { work(n * t / nthreads, n * (t + 1) / nthreads); });
+    for (auto& thread : threads)
+	thread.join();
+}
+
+// Sort the records by the composite key `spec` using `nthreads`
+// threads. The normalized key prefix of every record is extracted once
+// in parallel; the (prefix, index) entries are sorted in per-thread
+// chunks that are then merged pairwise in parallel. Records are only
+// read again when two prefixes tie and the key is longer than the
+// prefix. The records are finally permuted in place.
+void sort_records(const Records& recs, const KeySpec& spec, size_t nthreads) {
+    if (recs.nrecords > std::numeric_limits<uint32_t>::max())
+	throw std::length_error("sort_records: more than 2^32 - 1 records");
+    nthreads = std::max<size_t>(1, std::min(nthreads, recs.nrecords / 1024 + 1));
+    const auto length = key_length(spec);
+    const bool complete = length <= PrefixEntry::PrefixBytes;
+
+    std::vector<PrefixEntry> entries(recs.nrecords);
+    parallel_for(recs.nrecords, nthreads, [&](size_t begin, size_t end) {
+	std::vector<uint8_t> key(std::max(length, PrefixEntry::PrefixBytes));
+	for (auto i = begin; i < end; ++i) {
+	    normalize_key(spec, recs[i], key.data());
+	    entries[i] = PrefixEntry{load_be64(key.data()), load_be64(key.data() + 8), uint32_t(i)};
+	}
+    });
+
+    auto less = [&](const PrefixEntry& a, const PrefixEntry& b) {
+	if (a.hi != b.hi) return a.hi < b.hi;
+	if (a.lo != b.lo) return a.lo < b.lo;
+	if (not complete) {
+	    thread_local std::vector<uint8_t> ka, kb;
+	    ka.resize(length);
+	    kb.resize(length);
+	    normalize_key(spec, recs[a.index], ka.data());
+	    normalize_key(spec, recs[b.index], kb.data());
+	    auto r = std::memcmp(ka.data() + PrefixEntry::PrefixBytes, kb.data() + PrefixEntry::PrefixBytes,
+				 length - PrefixEntry::PrefixBytes);
+	    if (r != 0) return r < 0;
+	}
+	return a.index < b.index;
+    };
+
+    std::vector<size_t> bounds;
+    for (size_t t = 0; t <= nthreads; ++t)
+	bounds.push_back(entries.size() * t / nthreads);
+    parallel_for(nthreads, nthreads, [&](size_t t, size_t) {
+	std::sort(entries.begin() + bounds[t], entries.begin() + bounds[t + 1], less);
+    });
+    for (size_t step = 1; step < nthreads; step *= 2) {
+	std::vector<std::thread> threads;
+	for (size_t t = 0; t + step < nthreads; t += 2 * step) {
+	    auto first = entries.begin() + bounds[t];
+	    auto middle = entries.begin() + bounds[t + step];
+	    auto last = entries.begin() + bounds[std::min(t + 2 * step, nthreads)];
+	    threads.emplace_back([=]() { std::inplace_merge(first, middle, last, less); });
+	}
+	for (auto& thread : threads)
+	    thread.join();
+    }
+
+    std::vector<KeyIndex> order(entries.size());
+    for (size_t i = 0; i < entries.size(); ++i)
+	order[i] = entries[i].index;
+    entries = {};
+    permute_in_place(recs, order);
+}
+
+// Compare two records field by field without normalizing, as a
+// handwritten comparator would.
+bool key_less(const KeySpec& spec, const uint8_t *a, const uint8_t *b) {
+    for (const auto& field : spec) {
+	auto pa = a + field.offset, pb = b + field.offset;
+	int r{};
+	auto cmp = [](auto x, auto y) { return x < y ? -1 : y < x ? 1 : 0; };
+	auto load = [&]<class T>(const uint8_t *ptr) { T v; std::memcpy(&v, ptr, sizeof(T)); return v; };
+	switch (field.type) {
+	case KeyType::Bytes:
+	    r = std::memcmp(pa, pb, field.width);
+	    break;
+	case KeyType::Float:
+	    r = field.width == 4
+		? cmp(load.operator()<float>(pa), load.operator()<float>(pb))
+		: cmp(load.operator()<double>(pa), load.operator()<double>(pb));
+	    break;
+	case KeyType::Int:
+	case KeyType::Uint: {
+	    uint64_t ua{}, ub{};
+	    std::memcpy(&ua, pa, field.width);
+	    std::memcpy(&ub, pb, field.width);
+	    if (field.type == KeyType::Int) {
+		auto shift = 64 - 8 * field.width;
+		r = cmp(int64_t(ua << shift) >> shift, int64_t(ub << shift) >> shift);
+	    } else {
+		r = cmp(ua, ub);
+	    }
+	    break;
+	}
+	}
+	if (r != 0)
+	    return field.descending ? r > 0 : r < 0;
+    }
+    return false;
+}
+
+void bench_multikey(size_t nrecords, size_t nbytes, size_t max_threads) {
+    // A low-cardinality short, a 9-byte string from a two letter
+    // alphabet (descending), a double and an unsigned int (descending):
+    // 23 bytes normalized, so some prefixes tie and need the full key.
+    KeySpec spec = {
+	{ 0, 2, KeyType::Int },
+	{ 2, 9, KeyType::Bytes, true },
+	{ 11, 8, KeyType::Float },
+	{ 19, 4, KeyType::Uint, true },
+    };
+    nbytes = std::max(nbytes, key_length(spec));
+
+    std::vector<uint8_t> data(nrecords * nbytes), original;
+    std::mt19937_64 rng;
+    std::uniform_int_distribution<uint8_t> d;
+    std::normal_distribution<double> nd(0.0, 1e3);
+    std::generate(data.begin(), data.end(), [&]() { return d(rng); });
+    Records recs{data.data(), nrecords, nbytes};
+    for (size_t i = 0; i < nrecords; ++i) {
+	auto rec = recs[i];
+	int16_t a = int16_t(rng() % 8) - 4;
+	std::memcpy(rec, &a, sizeof(a));
+	for (int j = 0; j < 9; ++j)
+	    rec[2 + j] = "ab"[rng() % 2];
+	double x = std::round(nd(rng));
+	std::memcpy(rec + 11, &x, sizeof(x));
+    }
+    original = data;
+
+    cout << "multikey: " << nrecords << " records of " << nbytes << " bytes, "
+	 << key_length(spec) << " byte key" << endl;
+
+    std::vector<uint32_t> index(nrecords);
+    std::iota(index.begin(), index.end(), 0);
+    auto base_ms = measure([&]() {
+	std::stable_sort(index.begin(), index.end(), [&](uint32_t a, uint32_t b) {
+	    return key_less(spec, recs[a], recs[b]);
+	});
+    });
+    std::vector<uint8_t> expected(data.size());
+    for (size_t i = 0; i < nrecords; ++i)
+	std::memcpy(expected.data() + i * nbytes, recs[index[i]], nbytes);
+    cout << "  index-sort (field comparator): " << base_ms << " ms" << endl;
+
+    for (size_t nthreads = 1; nthreads <= max_threads; nthreads *= 2) {
+	data = original;
+	auto ms = measure([&]() { sort_records(recs, spec, nthreads); });
+	cout << "  prefix-sort " << nthreads << " thread(s): " << ms << " ms"
+	     << (data == expected ? "" : " WRONG ORDER") << endl;
+    }
+}
+
+// The benchmarks selected by the command line. The key is the int at
+// `key_index`, moved left to fit in short records; a record narrower
+// than the key has no room for it, which is reported as
+// invalid_argument.
+int run_benchmarks(int argc, const char *argv[], int key_index) {
+    auto key_for = [&](size_t width) {
+	if (width < sizeof(int32_t))
+	    throw std::invalid_argument("p4: record width must be at least 4 bytes");
+	return std::min<size_t>(key_index, width - sizeof(int32_t));
+    };
+
+    // p4 external [nrecords [nbytes [memory-mb]]]: out-of-core sort.
+    if (argc > 1 and std::string_view(argv[1]) == "external") {
+	size_t n = argc > 2 ? std::stoul(argv[2]) : 10'000'000;
+	size_t width = argc > 3 ? std::stoul(argv[3]) : 100;
+	size_t memory_mb = argc > 4 ? std::stoul(argv[4]) : 64;
+	bench_external(n, width, key_for(width), memory_mb);
+	return 0;
+    }
+
+    // p4 multikey [nrecords [nbytes [threads]]]: composite key sort.
+    if (argc > 1 and std::string_view(argv[1]) == "multikey") {
+	size_t n = argc > 2 ? std::stoul(argv[2]) : 1'000'000;
+	size_t width = argc > 3 ? std::stoul(argv[3]) : 100;
+	size_t nthreads = argc > 4 ? std::stoul(argv[4]) : std::thread::hardware_concurrency();
+	bench_multikey(n, width, std::max<size_t>(nthreads, 1));
+	return 0;
+    }
+
+    // p4 [nrecords [nbytes...]]: benchmark each record width.
+    size_t n = argc > 1 ? std::stoul(argv[1]) : 1'000'000;
+    std::vector<size_t> widths;
+    for (int i = 2; i < argc; ++i)
+	widths.push_back(std::stoul(argv[i]));
+    if (widths.empty())
+	widths = { 50, 100, 500 };
+    std::vector<size_t> keys;
+    for (auto width : widths)
+	keys.push_back(key_for(width));
+    for (size_t i = 0; i < widths.size(); ++i)
+	bench(n, widths[i], keys[i]);
+    return 0;
+}
+
 int main(int argc, const char *argv[]) {
     // We have 100 records each with 50 bytes.
     int nrecords = 100, nbytes = 50;
@@ -17,12 +744,17 @@ int main(int argc, const char *argv[]) {
     std::generate(data.begin(), data.end(), [&]() { return d(rng); });
 
     int key_index = 20;
-    auto cmp = [&](uint8_t *a, uint8_t *b) {
-	int aval = *(int*)(a + key_index), bval = *(int*)(b + key_index);
-	return aval < bval;
-    };
 
-    // How can I call std::sort with run-time record length?
-    // std::sort(data.begin(), ...)
-    return 0;
+    // How can I call std::sort with run-time record length? Sort the
+    // extracted keys and permute the records to match.
+    Records recs{data.data(), size_t(nrecords), size_t(nbytes)};
+    sort_records(recs, key_index);
+    cout << "sorted: " << std::boolalpha << is_sorted_records(recs, key_index) << endl;
+
+    try {
+	return run_benchmarks(argc, argv, key_index);
+    } catch (const std::invalid_argument& e) {
+	std::cerr << e.what() << endl;
+	return 1;
+    }
 }
@@ -1,9 +1,27 @@
 // Copyright (C) 2022, 2023 by Mark Melton
 //
 
+#include <algorithm>
+#include <atomic>
+#include <cctype>
+#include <cmath>
+#include <cstdint>
+#include <cstdio>
+#include <filesystem>
+#include <fstream>
+#include <iomanip>
 #include <iostream>
+#include <memory>
+#include <numbers>
+#include <sstream>
+#include <stdexcept>
 #include <string>
-#include <fstream>
+#include <thread>
+#include <vector>
+#ifdef __AVX2__
+#include <immintrin.h>
+#endif
+#include "core/timer/timer.h"
 
 //This string store the 16 pixels (3 pixels per color, 48 bytes values (code in int main(){}))
 std::string rgb_inp;
@@ -155,8 +173,1039 @@ void redim_img()
     }
 };
 
-int main()
+// Separable resampling.
+//
+// redim_img interpolates each output pixel from scratch. Since the
+// bicubic kernel is separable, the same result comes from filtering
+// each source row horizontally and then blending the filtered rows
+// vertically. The source positions and weights depend only on the
+// output column (or row), so they are computed once into tables, and
+// the two passes are straight loops over those tables.
+
+// An 8-bit image with `channels` interleaved samples per pixel and rows
+// `stride` bytes apart. A planar image is one view per channel.
+struct ImageView {
+    uint8_t *data;
+    int width, height, channels;
+    ptrdiff_t stride;
+
+    uint8_t *row(int y) const {
+	return data + y * stride;
+    }
+};
+
+// The taps along one axis: output sample i reads input sample
+// index[k * n + i] with weight weight[k * n + i] for k < taps. Storing
+// them tap-major lets the kernels load the taps of 8 consecutive
+// outputs at once. Indices are already clamped to the input. `fixed`
+// holds the weights in FixedBits fixed point for the integer kernels.
+//
+// The integer horizontal pass reads its taps two at a time (see
+// pair_taps): output sample i covers the `span` input samples from
+// first[i] on, `step` / 2 apart, and pairs[p * n + i] holds the fixed
+// weights of taps 2p and 2p + 1 as the low and high int16 of a word.
+struct AxisTable {
+    int taps{}, n{};
+    std::vector<int32_t> index;
+    std::vector<float> weight;
+    std::vector<int16_t> fixed;
+    int span{}, step{};
+    std::vector<int32_t> first, pairs;
+};
+
+// Fixed-point format of the integer kernels. Weights have FixedBits
+// fraction bits, so |weight| < 2 fits int16. The horizontal pass keeps
+// MidBits fraction bits in its int16 output: overshoot of about +-30%
+// of 255 at that scale still fits, and the vertical accumulation of a
+// few such samples times weights fits int32.
+constexpr int FixedBits = 14, MidBits = 6;
+
+// Round the weights of `table` to fixed point. The rounding error of
+// each output position goes to its largest tap so the fixed weights
+// still sum to exactly 1 and flat regions stay flat.
+void quantize(AxisTable& table) {
+    const int n = table.n;
+    table.fixed.resize(table.weight.size());
+    for (int i = 0; i < n; ++i) {
+	int sum{}, largest{};
+	for (int k = 0; k < table.taps; ++k) {
+	    table.fixed[k * n + i] = int16_t(std::lround(table.weight[k * n + i] * (1 << FixedBits)));
+	    sum += table.fixed[k * n + i];
+	    if (table.weight[k * n + i] > table.weight[largest * n + i])
+		largest = k;
+	}
+	table.fixed[largest * n + i] += (1 << FixedBits) - sum;
+    }
+}
+
+// Rewrite the fixed weights of `table`, along an axis of `in_size`
+// positions with `channels` interleaved samples each, as contiguous
+// windows of an even number of taps. Clamping repeats edge samples, so
+// a window is shifted inward and the weights of repeated samples are
+// added up, which leaves every sum unchanged. A window that would run
+// past the input (only when it covers all of it) gets zero weights
+// there.
+void pair_taps(AxisTable& table, int in_size, int channels) {
+    const int n = table.n;
+    table.span = (std::min(table.taps, in_size) + 1) / 2 * 2;
+    table.step = 2 * channels;
+    table.first.resize(n);
+    table.pairs.assign(size_t(table.span / 2) * n, 0);
+    std::vector<int32_t> w(table.span);
+    for (int i = 0; i < n; ++i) {
+	int lo = table.index[i] / channels;
+	for (int k = 1; k < table.taps; ++k)
+	    lo = std::min(lo, table.index[k * n + i] / channels);
+	int start = std::min(lo, std::max(0, in_size - table.span));
+	std::fill(w.begin(), w.end(), 0);
+	for (int k = 0; k < table.taps; ++k)
+	    w[table.index[k * n + i] / channels - start] += table.fixed[k * n + i];
+	table.first[i] = start * channels + i % channels;
+	for (int p = 0; p < table.span / 2; ++p)
+	    table.pairs[p * n + i] = int32_t(uint16_t(w[2 * p]) | uint32_t(uint16_t(w[2 * p + 1])) << 16);
+    }
+}
+
+// The weights bicub_hermite applies to p0..p3 (Catmull-Rom).
+inline void catmull_rom(float t, float w[4]) {
+    float t2 = t * t, t3 = t2 * t;
+    w[0] = -0.5f * t3 + t2 - 0.5f * t;
+    w[1] = 1.5f * t3 - 2.5f * t2 + 1.0f;
+    w[2] = -1.5f * t3 + 2.0f * t2 + 0.5f * t;
+    w[3] = 0.5f * t3 - 0.5f * t2;
+}
+
+AxisTable make_table(int taps, int out_size, int channels) {
+    AxisTable table{taps, out_size * channels};
+    table.index.resize(size_t(table.taps) * table.n);
+    table.weight.resize(size_t(table.taps) * table.n);
+    return table;
+}
+
+// Give output position `o` the taps first, first + 1, ... (clamped to
+// the input, which repeats the edge samples) with weights `w`, for each
+// of `channels` interleaved samples. Every filter builds its table this
+// way, so the window of source rows under the taps is contiguous and
+// moves forward with `o`, as the ring in Resampler requires.
+void set_taps(AxisTable& table, int o, int channels, int first, const float *w, int in_size) {
+    for (int k = 0; k < table.taps; ++k) {
+	int src = std::clamp(first + k, 0, in_size - 1);
+	for (int ch = 0; ch < channels; ++ch) {
+	    table.index[k * table.n + o * channels + ch] = src * channels + ch;
+	    table.weight[k * table.n + o * channels + ch] = w[k];
+	}
+    }
+}
+
+// Bicubic taps from `in_size` to `out_size` positions using the
+// coordinate mapping of pixel_interp, expanded to `channels`
+// interleaved samples per position.
+AxisTable bicubic_table(int in_size, int out_size, int channels) {
+    auto table = make_table(4, out_size, channels);
+    for (int o = 0; o < out_size; ++o) {
+	float u = out_size > 1 ? float(o) / float(out_size - 1) : 0.0f;
+	float cord = u * in_size - 0.5;
+	int ent = int(cord);
+	float w[4];
+	catmull_rom(cord - ent, w);
+	set_taps(table, o, channels, ent - 1, w, in_size);
+    }
+    quantize(table);
+    return table;
+}
+
+// Taps of `kernel`, which is zero outside [-support, support], centred
+// on each output sample's position in the input (pixel centres aligned).
+// When downscaling, the kernel is stretched by the scale factor so it
+// covers the output sample's whole footprint instead of aliasing.
+// Weights are normalized to sum to 1.
+template<class Kernel>
+AxisTable kernel_table(int in_size, int out_size, int channels, double support, Kernel&& kernel) {
+    double scale = double(in_size) / out_size, stretch = std::max(scale, 1.0);
+    double radius = support * stretch;
+    auto table = make_table(int(std::ceil(2 * radius)) + 1, out_size, channels);
+    std::vector<float> w(table.taps);
+    for (int o = 0; o < out_size; ++o) {
+	double center = (o + 0.5) * scale - 0.5;
+	int first = int(std::ceil(center - radius));
+	double sum{};
+	for (int k = 0; k < table.taps; ++k)
+	    sum += w[k] = float(kernel((first + k - center) / stretch));
+	for (auto& wk : w)
+	    wk = float(wk / sum);
+	set_taps(table, o, channels, first, w.data(), in_size);
+    }
+    quantize(table);
+    return table;
+}
+
+// Box filter over each output sample's footprint: every input sample
+// is weighted by how much of it the footprint covers. Downscaling by an
+// integer factor averages whole blocks.
+AxisTable area_table(int in_size, int out_size, int channels) {
+    double scale = double(in_size) / out_size;
+    auto table = make_table(int(std::ceil(scale)) + 1, out_size, channels);
+    std::vector<float> w(table.taps);
+    for (int o = 0; o < out_size; ++o) {
+	double lo = o * scale, hi = std::min(lo + scale, double(in_size));
+	int first = int(std::floor(lo));
+	for (int k = 0; k < table.taps; ++k) {
+	    int j = first + k;
+	    w[k] = float(std::max(0.0, std::min(j + 1.0, hi) - std::max(double(j), lo)) / (hi - lo));
+	}
+	set_taps(table, o, channels, first, w.data(), in_size);
+    }
+    quantize(table);
+    return table;
+}
+
+// Bicubic is the original Catmull-Rom interpolation with its own
+// coordinate mapping and no widening when downscaling. The others are
+// pixel-centre aligned and antialias when downscaling.
+enum class Filter { Bicubic, Bilinear, Lanczos3, Area };
+
+inline const char *filter_name(Filter filter) {
+    switch (filter) {
+    case Filter::Bicubic: return "bicubic";
+    case Filter::Bilinear: return "bilinear";
+    case Filter::Lanczos3: return "lanczos3";
+    case Filter::Area: return "area";
+    }
+    return "?";
+}
+
+inline Filter parse_filter(const std::string& name) {
+    for (auto filter : { Filter::Bicubic, Filter::Bilinear, Filter::Lanczos3, Filter::Area })
+	if (name == filter_name(filter))
+	    return filter;
+    throw std::invalid_argument("unknown filter: " + name);
+}
+
+inline double sinc(double x) {
+    return x == 0 ? 1.0 : std::sin(std::numbers::pi * x) / (std::numbers::pi * x);
+}
+
+AxisTable filter_table(Filter filter, int in_size, int out_size, int channels) {
+    switch (filter) {
+    case Filter::Bilinear:
+	return kernel_table(in_size, out_size, channels, 1.0, [](double x) {
+	    return std::max(0.0, 1.0 - std::abs(x));
+	});
+    case Filter::Lanczos3:
+	return kernel_table(in_size, out_size, channels, 3.0, [](double x) {
+	    return std::abs(x) < 3.0 ? sinc(x) * sinc(x / 3.0) : 0.0;
+	});
+    case Filter::Area:
+	return area_table(in_size, out_size, channels);
+    case Filter::Bicubic:
+	break;
+    }
+    return bicubic_table(in_size, out_size, channels);
+}
+
+#ifdef __AVX2__
+inline __m256 fmadd(__m256 a, __m256 b, __m256 c) {
+#ifdef __FMA__
+    return _mm256_fmadd_ps(a, b, c);
+#else
+    return _mm256_add_ps(_mm256_mul_ps(a, b), c);
+#endif
+}
+#endif
+
+// Horizontal pass: dst[i] = sum over k of weight * src[index].
+void filter_row(const AxisTable& table, const float *src, float *dst) {
+    const int n = table.n;
+    int i = 0;
+#ifdef __AVX2__
+    for (; i + 8 <= n; i += 8) {
+	auto acc = _mm256_setzero_ps();
+	for (int k = 0; k < table.taps; ++k) {
+	    auto idx = _mm256_loadu_si256(reinterpret_cast<const __m256i*>(&table.index[k * n + i]));
+	    auto w = _mm256_loadu_ps(&table.weight[k * n + i]);
+	    acc = fmadd(w, _mm256_i32gather_ps(src, idx, 4), acc);
+	}
+	_mm256_storeu_ps(dst + i, acc);
+    }
+#endif
+    for (; i < n; ++i) {
+	float acc{};
+	for (int k = 0; k < table.taps; ++k)
+	    acc += table.weight[k * n + i] * src[table.index[k * n + i]];
+	dst[i] = acc;
+    }
+}
+
+// Widen `n` 8-bit samples to float for the horizontal pass.
+void widen_row(const uint8_t *src, int n, float *dst) {
+    int i = 0;
+#ifdef __AVX2__
+    for (; i + 8 <= n; i += 8) {
+	auto bytes = _mm_loadl_epi64(reinterpret_cast<const __m128i*>(src + i));
+	_mm256_storeu_ps(dst + i, _mm256_cvtepi32_ps(_mm256_cvtepu8_epi32(bytes)));
+    }
+#endif
+    for (; i < n; ++i)
+	dst[i] = src[i];
+}
+
+// Vertical pass: out[i] = sum over k of w[k] * rows[k][i], clamped to
+// 0..255 and truncated like pixel_interp. The saturating packs do the
+// clamping.
+void blend_rows(const float *const *rows, const float *w, int taps, int n, uint8_t *out) {
+    int i = 0;
+#ifdef __AVX2__
+    const auto order = _mm256_setr_epi32(0, 4, 1, 5, 2, 6, 3, 7);
+    for (; i + 16 <= n; i += 16) {
+	auto a = _mm256_setzero_ps(), b = _mm256_setzero_ps();
+	for (int k = 0; k < taps; ++k) {
+	    auto wk = _mm256_set1_ps(w[k]);
+	    a = fmadd(wk, _mm256_loadu_ps(rows[k] + i), a);
+	    b = fmadd(wk, _mm256_loadu_ps(rows[k] + i + 8), b);
+	}
+	auto words = _mm256_packus_epi32(_mm256_cvttps_epi32(a), _mm256_cvttps_epi32(b));
+	auto bytes = _mm256_permutevar8x32_epi32(_mm256_packus_epi16(words, words), order);
+	_mm_storeu_si128(reinterpret_cast<__m128i*>(out + i), _mm256_castsi256_si128(bytes));
+    }
+#endif
+    for (; i < n; ++i) {
+	float acc{};
+	for (int k = 0; k < taps; ++k)
+	    acc += w[k] * rows[k][i];
+	out[i] = static_cast<uint8_t>(def_lims(acc, 255.0f));
+    }
+}
+
+// The integer kernels mirror the float ones. Each source sample is
+// widened to a word holding it and the sample of the same channel in
+// the next position, as two int16 (the last position repeats itself)...
+void widen_row(const uint8_t *src, int n, int channels, int32_t *dst) {
+    int i = 0;
+#ifdef __AVX2__
+    for (; i + channels + 8 <= n; i += 8) {
+	auto lo = _mm256_cvtepu8_epi32(_mm_loadl_epi64(reinterpret_cast<const __m128i*>(src + i)));
+	auto hi = _mm256_cvtepu8_epi32(_mm_loadl_epi64(reinterpret_cast<const __m128i*>(src + i + channels)));
+	_mm256_storeu_si256(reinterpret_cast<__m256i*>(dst + i), _mm256_or_si256(lo, _mm256_slli_epi32(hi, 16)));
+    }
+#endif
+    for (; i < n; ++i)
+	dst[i] = src[i] | (i + channels < n ? src[i + channels] : src[i]) << 16;
+}
+
+// ...so one gather fetches two taps of 8 outputs, which madd multiplies
+// by the paired weights and adds, 16 taps per instruction. The sums
+// are rounded to MidBits fraction bits...
+void filter_row(const AxisTable& table, const int32_t *src, int16_t *dst) {
+    constexpr int Shift = FixedBits - MidBits, Round = 1 << (Shift - 1);
+    const int n = table.n, npairs = table.span / 2, step = table.step;
+    int i = 0;
+#ifdef __AVX2__
+    for (; i + 8 <= n; i += 8) {
+	auto acc = _mm256_set1_epi32(Round);
+	auto idx = _mm256_loadu_si256(reinterpret_cast<const __m256i*>(&table.first[i]));
+	for (int p = 0; p < npairs; ++p) {
+	    auto w = _mm256_loadu_si256(reinterpret_cast<const __m256i*>(&table.pairs[p * n + i]));
+	    acc = _mm256_add_epi32(acc, _mm256_madd_epi16(w, _mm256_i32gather_epi32(src, idx, 4)));
+	    idx = _mm256_add_epi32(idx, _mm256_set1_epi32(step));
+	}
+	acc = _mm256_srai_epi32(acc, Shift);
+	auto words = _mm256_permute4x64_epi64(_mm256_packs_epi32(acc, acc), 0x08);
+	_mm_storeu_si128(reinterpret_cast<__m128i*>(dst + i), _mm256_castsi256_si128(words));
+    }
+#endif
+    for (; i < n; ++i) {
+	int32_t acc = Round;
+	for (int p = 0; p < npairs; ++p) {
+	    int32_t w = table.pairs[p * n + i], pair = src[table.first[i] + p * step];
+	    acc += int16_t(w) * (pair & 0xffff) + (w >> 16) * (pair >> 16);
+	}
+	dst[i] = int16_t(std::clamp(acc >> Shift, -32768, 32767));
+    }
+}
+
+// ...and blended two rows at a time with madd, 16 samples per
+// instruction and 32 per iteration, so each pair of weights is
+// broadcast once for four accumulators. The result is truncated like
+// the float path and the saturating packs clamp it to 0..255.
+void blend_rows(const int16_t *const *rows, const int16_t *w, int taps, int n, uint8_t *out) {
+    constexpr int Shift = FixedBits + MidBits;
+    int i = 0;
+#ifdef __AVX2__
+    auto load = [](const int16_t *p) { return _mm256_loadu_si256(reinterpret_cast<const __m256i*>(p)); };
+    auto pack = [](__m256i lo, __m256i hi) {
+	// unpacklo/hi split each lane, so packing lo with hi restores order.
+	return _mm256_packus_epi32(_mm256_srai_epi32(lo, Shift), _mm256_srai_epi32(hi, Shift));
+    };
+    for (; i + 32 <= n; i += 32) {
+	__m256i acc[4] = {};
+	for (int k = 0; k < taps; k += 2) {
+	    const int16_t *r0 = rows[k] + i, *r1 = rows[k + 1 < taps ? k + 1 : k] + i;
+	    auto wk = _mm256_set1_epi32(int32_t(uint16_t(w[k]) | uint32_t(k + 1 < taps ? w[k + 1] : 0) << 16));
+	    auto a = load(r0), b = load(r1), c = load(r0 + 16), d = load(r1 + 16);
+	    acc[0] = _mm256_add_epi32(acc[0], _mm256_madd_epi16(_mm256_unpacklo_epi16(a, b), wk));
+	    acc[1] = _mm256_add_epi32(acc[1], _mm256_madd_epi16(_mm256_unpackhi_epi16(a, b), wk));
+	    acc[2] = _mm256_add_epi32(acc[2], _mm256_madd_epi16(_mm256_unpacklo_epi16(c, d), wk));
+	    acc[3] = _mm256_add_epi32(acc[3], _mm256_madd_epi16(_mm256_unpackhi_epi16(c, d), wk));
+	}
+	auto bytes = _mm256_packus_epi16(pack(acc[0], acc[1]), pack(acc[2], acc[3]));
+	_mm256_storeu_si256(reinterpret_cast<__m256i*>(out + i), _mm256_permute4x64_epi64(bytes, 0xd8));
+    }
+#endif
+    for (; i < n; ++i) {
+	int32_t acc{};
+	for (int k = 0; k < taps; ++k)
+	    acc += w[k] * rows[k][i];
+	out[i] = uint8_t(std::clamp(acc >> Shift, 0, 255));
+    }
+}
+
+// Arithmetic of the resampler: float, or the integer kernels with
+// int16 weights and intermediate rows and int32 accumulation.
+enum class Precision { Float, Fixed };
+
+// Resamples images of one size and channel count to another with
+// precomputed tables. Each call to run() keeps the horizontally
+// filtered source rows it needs in a ring of `taps` rows; the vertical
+// taps of consecutive output rows move forward through the source, so
+// every source row is converted and filtered at most once per call and
+// nothing is allocated per pixel or per row.
+
+class Resampler {
+public:
+    Resampler(int in_w, int in_h, int out_w, int out_h, int channels,
+	      Precision precision = Precision::Float, Filter filter = Filter::Bicubic)
+	: horizontal_(filter_table(filter, in_w, out_w, channels))
+	, vertical_(filter_table(filter, in_h, out_h, 1))
+	, in_samples_(in_w * channels)
+	, channels_(channels)
+	, precision_(precision) {
+	pair_taps(horizontal_, in_w, channels);
+    }
+
+    // Produce output rows [y0, y1). `source(y)` returns source row y;
+    // it is called with increasing y and only for rows under the
+    // vertical taps, and each returned row is used before the next call.
+    // `target(y)` returns where to write output row y; it is called for
+    // each row in order.
+    template<class Source, class Target>
+    void run_rows(Source&& source, Target&& target, int y0, int y1) const {
+	if (precision_ == Precision::Fixed)
+	    run_rows<int32_t, int16_t>(source, target, y0, y1, vertical_.fixed);
+	else
+	    run_rows<float, float>(source, target, y0, y1, vertical_.weight);
+    }
+
+    // Produce output rows [y0, y1) of `out` from `in`.
+    void run(const ImageView& in, const ImageView& out, int y0, int y1) const {
+	run_rows([&](int y) { return in.row(y); }, [&](int y) { return out.row(y); }, y0, y1);
+    }
+
+    void run(const ImageView& in, const ImageView& out) const {
+	run(in, out, 0, out.height);
+    }
+
+private:
+    // Source rows are widened to Wide and filtered into Mid rows; the
+    // vertical weights are of type Mid too.
+    template<class Wide, class Mid, class Source, class Target>
+    void run_rows(Source& source, Target& target, int y0, int y1,
+	     const std::vector<Mid>& vweight) const {
+	const int taps = vertical_.taps, n = horizontal_.n, out_h = vertical_.n;
+	std::vector<Wide> src(in_samples_);
+	std::vector<Mid> ring(size_t(taps) * n), weights(taps);
+	std::vector<int> ring_row(taps, -1);
+	std::vector<const Mid*> rows(taps);
+	for (int y = y0; y < y1; ++y) {
+	    for (int k = 0; k < taps; ++k) {
+		int sy = vertical_.index[k * out_h + y];
+		Mid *slot = &ring[size_t(sy % taps) * n];
+		if (ring_row[sy % taps] != sy) {
+		    if constexpr (std::is_same_v<Wide, float>)
+			widen_row(source(sy), in_samples_, src.data());
+		    else
+			widen_row(source(sy), in_samples_, channels_, src.data());
+		    filter_row(horizontal_, src.data(), slot);
+		    ring_row[sy % taps] = sy;
+		}
+		rows[k] = slot;
+		weights[k] = vweight[k * out_h + y];
+	    }
+	    blend_rows(rows.data(), weights.data(), taps, n, target(y));
+	}
+    }
+
+    AxisTable horizontal_, vertical_;
+    int in_samples_, channels_;
+    Precision precision_;
+};
+
+// An owning 8-bit image, interleaved or with one plane per channel.
+struct Image {
+    int width, height, channels;
+    bool planar;
+    std::vector<uint8_t> data;
+
+    Image(int w, int h, int c, bool planar_ = false)
+	: width(w), height(h), channels(c), planar(planar_), data(size_t(w) * h * c) {
+    }
+
+    // The interleaved image, or plane `p` of a planar one.
+    ImageView view(int p = 0) {
+	if (planar)
+	    return ImageView{ data.data() + size_t(p) * width * height, width, height, 1, width };
+	return ImageView{ data.data(), width, height, channels, ptrdiff_t(width) * channels };
+    }
+
+    int planes() const {
+	return planar ? channels : 1;
+    }
+};
+
+// Resample `in` into `out` using `nthreads` threads. The output rows of
+// each plane are split into bands that the threads claim from a shared
+// counter; each band runs the resampler over its own rows with its own
+// ring of filtered source rows, so bands share nothing but the tables.
+// Source rows under the vertical taps of two bands are filtered by
+// both, which is why bands are kept at least MinBand rows tall.
+void resample(Image& in, Image& out, int nthreads = 1, Precision precision = Precision::Float,
+	      Filter filter = Filter::Bicubic) {
+    constexpr int MinBand = 32;
+    Resampler resampler(in.width, in.height, out.width, out.height, in.planar ? 1 : in.channels,
+			precision, filter);
+    if (nthreads <= 1) {
+	for (int p = 0; p < in.planes(); ++p)
+	    resampler.run(in.view(p), out.view(p));
+	return;
+    }
+
+    // About four bands per thread so uneven bands even out.
+    int band = std::max(MinBand, (out.height * in.planes() + 4 * nthreads - 1) / (4 * nthreads));
+    int bands_per_plane = (out.height + band - 1) / band;
+    size_t nbands = size_t(bands_per_plane) * in.planes();
+
+    std::atomic<size_t> next{0};
+    auto worker = [&]() {
+	for (size_t b; (b = next++) < nbands; ) {
+	    int p = int(b / bands_per_plane), y0 = int(b % bands_per_plane) * band;
+	    resampler.run(in.view(p), out.view(p), y0, std::min(y0 + band, out.height));
+	}
+    };
+    std::vector<std::thread> threads;
+    for (int i = 1; i < nthreads; ++i)
+	threads.emplace_back(worker);
+    worker();
+    for (auto& thread : threads)
+	thread.join();
+}
+
+// Convert between interleaved and planar layouts.
+Image to_planar(const Image& in) {
+    Image out(in.width, in.height, in.channels, true);
+    size_t npixels = size_t(in.width) * in.height;
+    for (size_t i = 0; i < npixels; ++i)
+	for (int c = 0; c < in.channels; ++c)
+	    out.data[c * npixels + i] = in.data[i * in.channels + c];
+    return out;
+}
+
+Image to_interleaved(const Image& in) {
+    Image out(in.width, in.height, in.channels, false);
+    size_t npixels = size_t(in.width) * in.height;
+    for (size_t i = 0; i < npixels; ++i)
+	for (int c = 0; c < in.channels; ++c)
+	    out.data[i * in.channels + c] = in.data[c * npixels + i];
+    return out;
+}
+
+// Streaming image files.
+//
+// ImageReader and ImageWriter move 24-bit RGB images between files and
+// the resampler one row at a time, so resample_file holds only a row
+// of the input, the ring of filtered rows and a row of the output no
+// matter how large the images are. Both formats are chosen by file
+// extension: .bmp is an uncompressed 24-bit BMP, anything else a binary
+// PPM (P6, maxval 255). BMP rows are BGR and padded to 4 bytes; the
+// reader and writer convert so callers always see packed RGB rows.
+
+struct FileCloser {
+    void operator()(std::FILE *f) const { std::fclose(f); }
+};
+using File = std::unique_ptr<std::FILE, FileCloser>;
+
+inline bool is_bmp(const std::string& path) {
+    return path.size() >= 4 and path.compare(path.size() - 4, 4, ".bmp") == 0;
+}
+
+inline File open_file(const std::string& path, const char *mode) {
+    File f{std::fopen(path.c_str(), mode)};
+    if (not f)
+	throw std::runtime_error("cannot open " + path);
+    // Large stdio buffers so row-sized reads and writes stay cheap.
+    std::setvbuf(f.get(), nullptr, _IOFBF, 1 << 20);
+    return f;
+}
+
+inline void swap_red_blue(uint8_t *row, int width) {
+    for (int x = 0; x < width; ++x)
+	std::swap(row[3 * x], row[3 * x + 2]);
+}
+
+class ImageReader {
+public:
+    explicit ImageReader(const std::string& path)
+	: file_(open_file(path, "rb"))
+	, bmp_(is_bmp(path)) {
+	if (bmp_)
+	    read_bmp_header();
+	else
+	    read_ppm_header();
+	if (width_ <= 0 or height_ <= 0)
+	    throw std::runtime_error("ImageReader: bad dimensions in " + path);
+	file_stride_ = bmp_ ? (size_t(width_) * 3 + 3) / 4 * 4 : size_t(width_) * 3;
+	row_.resize(file_stride_);
+    }
+
+    int width() const { return width_; }
+    int height() const { return height_; }
+
+    // The packed RGB samples of row `y`, counting from the top. Rows
+    // must be requested in nondecreasing order; skipped rows are not
+    // read. The result is valid until the next call.
+    const uint8_t *row(int y) {
+	if (y == current_)
+	    return row_.data();
+	if (y < current_ or y >= height_)
+	    throw std::out_of_range("ImageReader: row out of order");
+	// Bottom-up BMP rows are stored last row first.
+	int file_row = bmp_ and bottom_up_ ? height_ - 1 - y : y;
+	off_t offset = data_offset_ + off_t(file_row) * off_t(file_stride_);
+	if (offset != position_ and fseeko(file_.get(), offset, SEEK_SET) != 0)
+	    throw std::runtime_error("ImageReader: seek failed");
+	if (std::fread(row_.data(), 1, file_stride_, file_.get()) != file_stride_)
+	    throw std::runtime_error("ImageReader: unexpected end of file");
+	position_ = offset + off_t(file_stride_);
+	if (bmp_)
+	    swap_red_blue(row_.data(), width_);
+	current_ = y;
+	return row_.data();
+    }
+
+private:
+    void read_bmp_header() {
+	uint8_t header[54];
+	if (std::fread(header, 1, sizeof(header), file_.get()) != sizeof(header)
+	    or header[0] != 'B' or header[1] != 'M')
+	    throw std::runtime_error("ImageReader: not a BMP file");
+	auto le32 = [&](int at) {
+	    return int32_t(header[at] | header[at + 1] << 8 | header[at + 2] << 16 | uint32_t(header[at + 3]) << 24);
+	};
+	auto le16 = [&](int at) { return header[at] | header[at + 1] << 8; };
+	if (le16(28) != 24 or le32(30) != 0)
+	    throw std::runtime_error("ImageReader: only uncompressed 24-bit BMP is supported");
+	data_offset_ = le32(10);
+	width_ = le32(18);
+	height_ = le32(22);
+	bottom_up_ = height_ > 0;
+	height_ = std::abs(height_);
+	position_ = sizeof(header);
+    }
+
+    // The next header token, skipping whitespace and comments.
+    int ppm_token() {
+	int c = std::fgetc(file_.get());
+	while (std::isspace(c) or c == '#') {
+	    if (c == '#')
+		while (c != '\n' and c != EOF)
+		    c = std::fgetc(file_.get());
+	    c = std::fgetc(file_.get());
+	}
+	int value{};
+	for (; std::isdigit(c); c = std::fgetc(file_.get()))
+	    value = 10 * value + (c - '0');
+	return value;
+    }
+
+    void read_ppm_header() {
+	if (std::fgetc(file_.get()) != 'P' or std::fgetc(file_.get()) != '6')
+	    throw std::runtime_error("ImageReader: not a binary PPM file");
+	width_ = ppm_token();
+	height_ = ppm_token();
+	if (ppm_token() != 255)
+	    throw std::runtime_error("ImageReader: only 8-bit PPM is supported");
+	// ppm_token consumed the single whitespace after maxval.
+	data_offset_ = position_ = ftello(file_.get());
+    }
+
+    File file_;
+    bool bmp_, bottom_up_{};
+    int width_{}, height_{}, current_{-1};
+    off_t data_offset_{}, position_{};
+    size_t file_stride_{};
+    std::vector<uint8_t> row_;
+};
+
+class ImageWriter {
+public:
+    ImageWriter(const std::string& path, int width, int height)
+	: file_(open_file(path, "wb"))
+	, bmp_(is_bmp(path))
+	, width_(width)
+	, height_(height)
+	, file_stride_(bmp_ ? (size_t(width) * 3 + 3) / 4 * 4 : size_t(width) * 3)
+	, row_(file_stride_) {
+	if (bmp_)
+	    write_bmp_header();
+	else
+	    std::fprintf(file_.get(), "P6\n%d %d\n255\n", width, height);
+    }
+
+    // Closing an unfinished image (say, while unwinding from a reader
+    // error) must not throw, so only flush and close; close() is where
+    // errors are reported.
+    ~ImageWriter() {
+	if (file_)
+	    std::fclose(file_.release());
+    }
+
+    // Write the row filled since the previous call, if any, and return
+    // the buffer for the next row (packed RGB).
+    uint8_t *next_row() {
+	flush_row();
+	pending_ = true;
+	return row_.data();
+    }
+
+    // Write the last row and close the file.
+    void close() {
+	flush_row();
+	if (written_ != height_)
+	    throw std::runtime_error("ImageWriter: wrong number of rows");
+	if (std::fclose(file_.release()) != 0)
+	    throw std::runtime_error("ImageWriter: close failed");
+    }
+
+private:
+    void flush_row() {
+	if (not pending_)
+	    return;
+	if (bmp_)
+	    swap_red_blue(row_.data(), width_);
+	if (std::fwrite(row_.data(), 1, file_stride_, file_.get()) != file_stride_)
+	    throw std::runtime_error("ImageWriter: write failed");
+	pending_ = false;
+	++written_;
+    }
+
+    // A top-down BMP (negative height) so rows go out in order.
+    void write_bmp_header() {
+	uint8_t header[54]{};
+	auto le32 = [&](int at, uint32_t v) {
+	    for (int i = 0; i < 4; ++i)
+		header[at + i] = uint8_t(v >> 8 * i);
+	};
+	header[0] = 'B';
+	header[1] = 'M';
+	le32(2, uint32_t(sizeof(header) + file_stride_ * height_));
+	le32(10, sizeof(header));
+	le32(14, 40);
+	le32(18, width_);
+	le32(22, uint32_t(-height_));
+	header[26] = 1;
+	header[28] = 24;
+	le32(34, uint32_t(file_stride_ * height_));
+	if (std::fwrite(header, 1, sizeof(header), file_.get()) != sizeof(header))
+	    throw std::runtime_error("ImageWriter: write failed");
+    }
+
+    File file_;
+    bool bmp_, pending_{};
+    int width_, height_, written_{};
+    size_t file_stride_;
+    std::vector<uint8_t> row_;
+};
+
+// Resample the image file `in_path` into `out_path` at `width` x
+// `height`, reading and writing a row at a time. The reader must see
+// rows in order, so this runs on one thread.
+void resample_file(const std::string& in_path, const std::string& out_path, int width, int height,
+		   Precision precision = Precision::Float, Filter filter = Filter::Bicubic) {
+    ImageReader reader(in_path);
+    ImageWriter writer(out_path, width, height);
+    Resampler resampler(reader.width(), reader.height(), width, height, 3, precision, filter);
+    resampler.run_rows([&](int y) { return reader.row(y); }, [&](int) { return writer.next_row(); },
+		       0, height);
+    writer.close();
+}
+
+// A smooth synthetic RGB test image with some high-frequency detail.
+void test_image_row(int w, int h, int y, uint8_t *row) {
+    for (int x = 0; x < w; ++x) {
+	row[3 * x] = uint8_t(x * 255 / std::max(w - 1, 1));
+	row[3 * x + 1] = uint8_t(y * 255 / std::max(h - 1, 1));
+	row[3 * x + 2] = uint8_t(((x / 8 + y / 8) % 2) * 200 + 27);
+    }
+}
+
+Image make_test_image(int w, int h) {
+    Image img(w, h, 3);
+    for (int y = 0; y < h; ++y)
+	test_image_row(w, h, y, &img.data[size_t(y) * w * 3]);
+    return img;
+}
+
+void report(const std::string& desc, int width, int height, double ns, const std::string& note = "") {
+    std::cout << "  " << desc << std::string(28 - std::min<size_t>(desc.size(), 27), ' ')
+	      << std::fixed << std::setprecision(2) << std::setw(8) << ns / 1e6 << " ms "
+	      << std::setw(8) << double(width) * height / ns * 1e3 << " Mpixel/s"
+	      << std::defaultfloat << note << std::endl;
+}
+
+void report(const std::string& desc, const Image& out, double ns, const std::string& note = "") {
+    report(desc, out.width, out.height, ns, note);
+}
+
+void bench_resample() {
+    // 4x4 -> 1920x1080, the original problem.
+    std::cout << "\n4x4 -> " << wide_end << "x" << height_end << ":" << std::endl;
+    Image small(wide_in, height_in, 3), up(wide_end, height_end, 3);
+    std::copy(rgb_inp.begin(), rgb_inp.end(), small.data.begin());
+    report("redim_img", up, core::timer::Timer().run(1, [&]() { redim_img(); }).elapsed_per_iteration());
+    report("separable interleaved", up, core::timer::Timer().run(20, [&]() {
+	resample(small, up);
+    }).elapsed_per_iteration());
+    int max_diff{};
+    for (size_t i = 0; i < up.data.size(); ++i)
+	max_diff = std::max(max_diff, std::abs(int(up.data[i]) - int(uint8_t(rgb_out[i]))));
+    std::cout << "  max difference from redim_img: " << max_diff << std::endl;
+
+    auto small_planar = to_planar(small);
+    Image up_planar(wide_end, height_end, 3, true);
+    report("separable planar", up_planar, core::timer::Timer().run(20, [&]() {
+	resample(small_planar, up_planar);
+    }).elapsed_per_iteration());
+
+    // 4K -> 1080p.
+    std::cout << "3840x2160 -> 1920x1080:" << std::endl;
+    auto big = make_test_image(3840, 2160), big_planar = to_planar(big);
+    Image down(1920, 1080, 3), down_planar(1920, 1080, 3, true);
+    report("separable interleaved", down, core::timer::Timer().run(10, [&]() {
+	resample(big, down);
+    }).elapsed_per_iteration());
+    report("separable planar", down_planar, core::timer::Timer().run(10, [&]() {
+	resample(big_planar, down_planar);
+    }).elapsed_per_iteration());
+    std::cout << "  planar matches interleaved: " << std::boolalpha
+	      << (to_interleaved(down_planar).data == down.data) << std::endl;
+}
+
+// Peak signal-to-noise ratio of `b` against `a` in dB (infinite when
+// they are equal).
+double psnr(const std::vector<uint8_t>& a, const std::vector<uint8_t>& b) {
+    double sse{};
+    for (size_t i = 0; i < a.size(); ++i)
+	sse += double(int(a[i]) - int(b[i])) * (int(a[i]) - int(b[i]));
+    return 10 * std::log10(255.0 * 255.0 * a.size() / sse);
+}
+
+// Compare the fixed-point kernels with the float ones for speed and,
+// as PSNR against the float output, accuracy.
+void bench_precision(Image& in, Image& out, int reps) {
+    std::cout << in.width << "x" << in.height << " -> " << out.width << "x" << out.height
+	      << ":" << std::endl;
+    Image fixed(out.width, out.height, out.channels);
+    auto float_ns = core::timer::Timer().run(reps, [&]() {
+	resample(in, out, 1, Precision::Float);
+    }).elapsed_per_iteration();
+    auto fixed_ns = core::timer::Timer().run(reps, [&]() {
+	resample(in, fixed, 1, Precision::Fixed);
+    }).elapsed_per_iteration();
+
+    int max_diff{};
+    for (size_t i = 0; i < out.data.size(); ++i)
+	max_diff = std::max(max_diff, std::abs(int(out.data[i]) - int(fixed.data[i])));
+    std::ostringstream note;
+    note << std::fixed << std::setprecision(2) << "  x" << float_ns / fixed_ns << "  PSNR "
+	 << psnr(out.data, fixed.data) << " dB, max diff " << max_diff;
+    report("float", out, float_ns);
+    report("fixed", fixed, fixed_ns, note.str());
+}
+
+void bench_fixed() {
+    std::cout << "\nFloat and fixed-point kernels:" << std::endl;
+    Image small(wide_in, height_in, 3), up(wide_end, height_end, 3);
+    std::copy(rgb_inp.begin(), rgb_inp.end(), small.data.begin());
+    bench_precision(small, up, 20);
+    auto big = make_test_image(3840, 2160);
+    Image down(1920, 1080, 3);
+    bench_precision(big, down, 10);
+}
+
+// Time the interleaved resample from `in` to `out` with 1, 2, 4, ...
+// up to `max_threads` threads and check every run against one thread.
+void bench_scaling(Image& in, Image& out, int max_threads, int reps) {
+    std::cout << in.width << "x" << in.height << " -> " << out.width << "x" << out.height
+	      << ":" << std::endl;
+    Image expected(out.width, out.height, out.channels);
+    resample(in, expected);
+    std::vector<int> counts;
+    for (int nthreads = 1; nthreads < max_threads; nthreads *= 2)
+	counts.push_back(nthreads);
+    counts.push_back(max_threads);
+
+    double base{};
+    for (auto nthreads : counts) {
+	auto ns = core::timer::Timer().run(reps, [&]() {
+	    resample(in, out, nthreads);
+	}).elapsed_per_iteration();
+	if (nthreads == 1)
+	    base = ns;
+	std::ostringstream note;
+	note << std::fixed << std::setprecision(2) << "  x" << base / ns
+	     << (out.data == expected.data ? "" : "  MISMATCH");
+	report(std::to_string(nthreads) + " thread(s)", out, ns, note.str());
+    }
+}
+
+void bench_threads(int max_threads) {
+    std::cout << "\nRow bands, up to " << max_threads << " thread(s):" << std::endl;
+    Image small(wide_in, height_in, 3), up(wide_end, height_end, 3);
+    std::copy(rgb_inp.begin(), rgb_inp.end(), small.data.begin());
+    bench_scaling(small, up, max_threads, 20);
+    auto big = make_test_image(3840, 2160);
+    Image down(1920, 1080, 3);
+    bench_scaling(big, down, max_threads, 10);
+}
+
+// Time every filter at several scale factors from a 1080p source. The
+// hot loops are the same for all of them; only the number of taps
+// differs. Each filter must also leave a flat field flat, in float and
+// in fixed point.
+void bench_filters() {
+    const Filter filters[] = { Filter::Bicubic, Filter::Bilinear, Filter::Lanczos3, Filter::Area };
+    const double scales[] = { 0.25, 0.5, 0.75, 1.5, 2.0 };
+    constexpr int Width = 1920, Height = 1080;
+    auto in = make_test_image(Width, Height);
+
+    std::cout << "\nFilters from " << Width << "x" << Height << ", ms per image (taps):\n"
+	      << std::string(10, ' ');
+    for (auto scale : scales)
+	std::cout << std::setw(12) << ("x" + std::to_string(scale).substr(0, 4));
+    std::cout << std::endl;
+
+    bool flat = true;
+    for (auto filter : filters) {
+	std::cout << std::setw(10) << std::left << filter_name(filter) << std::right;
+	for (auto scale : scales) {
+	    int w = int(Width * scale), h = int(Height * scale);
+	    Image out(w, h, 3);
+	    auto ns = core::timer::Timer().run(5, [&]() {
+		resample(in, out, 1, Precision::Float, filter);
+	    }).elapsed_per_iteration();
+	    auto taps = filter_table(filter, Width, w, 1).taps;
+	    std::ostringstream cell;
+	    cell << std::fixed << std::setprecision(2) << ns / 1e6 << " (" << taps << ")";
+	    std::cout << std::setw(12) << cell.str();
+
+	    Image gray(97, 61, 3);
+	    std::fill(gray.data.begin(), gray.data.end(), 173);
+	    for (auto precision : { Precision::Float, Precision::Fixed }) {
+		Image small(int(97 * scale) + 1, int(61 * scale) + 1, 3);
+		resample(gray, small, 1, precision, filter);
+		// The float path truncates, so 172.99... may come out as 172.
+		flat &= std::all_of(small.data.begin(), small.data.end(), [](auto v) {
+		    return v == 173 or v == 172;
+		});
+	    }
+	}
+	std::cout << std::endl;
+    }
+    std::cout << "  flat field preserved: " << std::boolalpha << flat << std::endl;
+}
+
+// Write a synthetic `width` x `height` test image to `path` a row at a
+// time.
+void write_test_file(const std::string& path, int width, int height) {
+    ImageWriter writer(path, width, height);
+    for (int y = 0; y < height; ++y)
+	test_image_row(width, height, y, writer.next_row());
+    writer.close();
+}
+
+inline size_t file_bytes(const std::string& path) {
+    return std::filesystem::file_size(path);
+}
+
+// End-to-end throughput of resample_file, counting the bytes read and
+// written, for BMP and PPM inputs of `width` x `height`. The 4K case
+// is checked against the in-memory resampler.
+void bench_io(int width, int height, int out_width, int out_height) {
+    auto dir = std::filesystem::temp_directory_path();
+    std::cout << "\nStreaming " << width << "x" << height << " -> " << out_width << "x"
+	      << out_height << " through " << dir.string() << ":" << std::endl;
+    Image expected(out_width, out_height, 3);
+    if (size_t(width) * height <= 3840 * 2160) {
+	auto in = make_test_image(width, height);
+	resample(in, expected);
+    }
+
+    for (auto ext : { ".ppm", ".bmp" }) {
+	auto in_path = (dir / (std::string("p6_in") + ext)).string();
+	auto out_path = (dir / (std::string("p6_out") + ext)).string();
+	write_test_file(in_path, width, height);
+	for (auto precision : { Precision::Float, Precision::Fixed }) {
+	    auto ns = core::timer::Timer().run(1, [&]() {
+		resample_file(in_path, out_path, out_width, out_height, precision);
+	    }).elapsed_per_iteration();
+	    auto nbytes = file_bytes(in_path) + file_bytes(out_path);
+
+	    std::ostringstream note;
+	    note << std::fixed << std::setprecision(1) << "  " << nbytes / ns * 1e3 << " MB/s";
+	    if (precision == Precision::Float and size_t(width) * height <= 3840 * 2160) {
+		ImageReader check(out_path);
+		bool same = true;
+		for (int y = 0; y < out_height; ++y)
+		    same &= std::equal(check.row(y), check.row(y) + out_width * 3,
+				       &expected.data[size_t(y) * out_width * 3]);
+		note << (same ? "" : "  MISMATCH");
+	    }
+	    report(std::string(ext + 1) + (precision == Precision::Fixed ? " fixed" : " float"),
+		   out_width, out_height, ns, note.str());
+	}
+	std::filesystem::remove(in_path);
+	std::filesystem::remove(out_path);
+    }
+}
+
+// p6 [-t threads]: the original upscale, then the resampler benchmarks
+// with row bands on up to `threads` threads (default: all cores).
+//
+// p6 stream [in out width height [filter]]: resample the BMP or PPM
+// file `in` into `out` a row at a time, or without arguments benchmark
+// streaming 4K and 8K files to 1080p. The filter is bicubic (default),
+// bilinear, lanczos3 or area.
+int main(int argc, const char *argv[])
 {
+    int nthreads = std::max(1u, std::thread::hardware_concurrency());
+    std::vector<std::string> args;
+    for (int i = 1; i < argc; ++i) {
+	if (std::string(argv[i]) == "-t" and i + 1 < argc)
+	    nthreads = std::max(1, std::stoi(argv[++i]));
+	else
+	    args.push_back(argv[i]);
+    }
+
+    if (not args.empty() and args[0] == "stream") {
+	if (args.size() >= 5) {
+	    auto filter = args.size() > 5 ? parse_filter(args[5]) : Filter::Bicubic;
+	    resample_file(args[1], args[2], std::stoi(args[3]), std::stoi(args[4]),
+			  Precision::Float, filter);
+	} else {
+	    bench_io(3840, 2160, 1920, 1080);
+	    bench_io(7680, 4320, 1920, 1080);
+	}
+	return 0;
+    }
+
     // Insert the 16 pixels
     rgb_inp.push_back(0x00);
     rgb_inp.push_back(0x00);
@@ -228,7 +1277,11 @@ int main()
     std::ofstream bmp_arch("/tmp/x_0.bmp", std::ios::binary);
     bmp_arch.write(bmp_out.data(), bmp_out.size());
     bmp_arch.close();
-    std::cout << "Finished";
+    std::cout << "Finished" << std::endl;
 
+    bench_resample();
+    bench_fixed();
+    bench_filters();
+    bench_threads(nthreads);
     return 0;
 }
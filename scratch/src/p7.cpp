@@ -2,8 +2,26 @@
 //
 
 #include <algorithm>
+#include <atomic>
+#include <bit>
+#include <bitset>
+#include <chrono>
+#include <cstdint>
+#include <deque>
+#include <iomanip>
 #include <iostream>
+#include <limits>
+#include <mutex>
+#include <random>
+#include <set>
+#include <stdexcept>
+#include <string_view>
+#include <thread>
 #include <vector>
+#ifdef __AVX2__
+#include <immintrin.h>
+#endif
+#include "core/timer/timer.h"
 
 using std::cout, std::endl;
 
@@ -60,8 +78,9 @@ auto brute_force(const Matrix& matrix, int sdx) {
 	if (i != sdx)
 	    vertex.push_back(i);
 
+    // The first permutation (vertex in order) is a tour too.
     auto min_cost = std::numeric_limits<int>::max();
-    while (std::next_permutation(vertex.begin(), vertex.end())) {
+    do {
 	int curr_cost{};
 	auto j = sdx;
 	for (int i = 0; i < vertex.size(); ++i) {
@@ -74,11 +93,1043 @@ auto brute_force(const Matrix& matrix, int sdx) {
 	    min_cost = std::min(min_cost, curr_cost);
 	    optimal = vertex;
 	}
-    }
+    } while (std::next_permutation(vertex.begin(), vertex.end()));
     optimal.insert(optimal.begin(), sdx);
     return std::make_pair(min_cost, optimal);
 }
 
+// Held-Karp.
+//
+// best[S][j] is the cost of the cheapest path that leaves the start,
+// visits exactly the vertices in subset S and ends at j (in S). It is
+// the minimum over k of best[S - j][k] + cost(k, j), where best is
+// infinite for k outside S - j, so each entry is a min-plus reduction
+// of one contiguous row of the table against one row of the transposed
+// cost matrix, with no test for membership. Subsets are numbered so
+// S - j < S and the rows are filled in increasing order of S.
+//
+// The table has 2^(n-1) rows of n-1 entries. When every tour costs
+// less than 2^16 the entries are uint16_t, which halves the memory
+// (805 MB at n = 25) and doubles the lanes per instruction; saturating
+// adds keep infinity infinite.
+
+template<class Value>
+inline constexpr Value Infinity = std::is_same_v<Value, uint16_t>
+    ? Value(0xffff) : Value(0x3fffffff);
+
+// The minimum over k < m of prev[k] + cost[k], saturating at Infinity.
+template<class Value>
+Value relax(const Value *prev, const Value *cost, int m) {
+    uint32_t best = Infinity<Value>;
+    for (int k = 0; k < m; ++k)
+	best = std::min<uint32_t>(best, uint32_t(prev[k]) + cost[k]);
+    return Value(std::min<uint32_t>(best, Infinity<Value>));
+}
+
+#ifdef __AVX2__
+template<>
+uint16_t relax<uint16_t>(const uint16_t *prev, const uint16_t *cost, int m) {
+    auto best = _mm256_set1_epi16(-1);
+    int k = 0;
+    for (; k + 16 <= m; k += 16) {
+	auto p = _mm256_loadu_si256(reinterpret_cast<const __m256i*>(prev + k));
+	auto c = _mm256_loadu_si256(reinterpret_cast<const __m256i*>(cost + k));
+	best = _mm256_min_epu16(best, _mm256_adds_epu16(p, c));
+    }
+    auto half = _mm_min_epu16(_mm256_castsi256_si128(best), _mm256_extracti128_si256(best, 1));
+    uint32_t result = _mm_extract_epi16(_mm_minpos_epu16(half), 0);
+    for (; k < m; ++k)
+	result = std::min<uint32_t>(result, uint32_t(prev[k]) + cost[k]);
+    return uint16_t(std::min<uint32_t>(result, 0xffff));
+}
+
+template<>
+uint32_t relax<uint32_t>(const uint32_t *prev, const uint32_t *cost, int m) {
+    auto best = _mm256_set1_epi32(Infinity<uint32_t>);
+    int k = 0;
+    for (; k + 8 <= m; k += 8) {
+	auto p = _mm256_loadu_si256(reinterpret_cast<const __m256i*>(prev + k));
+	auto c = _mm256_loadu_si256(reinterpret_cast<const __m256i*>(cost + k));
+	best = _mm256_min_epu32(best, _mm256_add_epi32(p, c));
+    }
+    auto half = _mm_min_epu32(_mm256_castsi256_si128(best), _mm256_extracti128_si256(best, 1));
+    half = _mm_min_epu32(half, _mm_shuffle_epi32(half, 0x4e));
+    half = _mm_min_epu32(half, _mm_shuffle_epi32(half, 0xb1));
+    uint32_t result = _mm_cvtsi128_si32(half);
+    for (; k < m; ++k)
+	result = std::min(result, prev[k] + cost[k]);
+    return std::min(result, Infinity<uint32_t>);
+}
+#endif
+
+template<class Value>
+std::pair<int, Order> held_karp(const Matrix& matrix, int sdx) {
+    const int n = matrix.nrows(), m = n - 1;
+    std::vector<int> others;
+    for (auto i = 0; i < n; ++i)
+	if (i != sdx)
+	    others.push_back(i);
+    if (m == 0)
+	return std::make_pair(matrix[sdx, sdx], Order{sdx});
+
+    // into[j * m + k] is the cost of k -> j.
+    std::vector<Value> into(m * m);
+    for (auto j = 0; j < m; ++j)
+	for (auto k = 0; k < m; ++k)
+	    into[j * m + k] = Value(matrix[others[k], others[j]]);
+
+    const uint32_t nsubsets = uint32_t(1) << m;
+    std::vector<Value> best(size_t(nsubsets) * m, Infinity<Value>);
+    auto row = [&](uint32_t subset) { return &best[size_t(subset) * m]; };
+    for (uint32_t subset = 1; subset < nsubsets; ++subset) {
+	auto entry = row(subset);
+	for (auto bits = subset; bits; bits &= bits - 1) {
+	    int j = std::countr_zero(bits);
+	    auto prev = subset ^ (uint32_t(1) << j);
+	    entry[j] = prev == 0
+		? Value(matrix[sdx, others[j]])
+		: relax<Value>(row(prev), &into[j * m], m);
+	}
+    }
+
+    // Close the tour, then walk back through the table: the vertex
+    // before j is any k whose entry plus cost(k, j) gives j's entry.
+    auto full = nsubsets - 1;
+    int cost = std::numeric_limits<int>::max(), last{};
+    for (auto j = 0; j < m; ++j) {
+	int c = int(row(full)[j]) + matrix[others[j], sdx];
+	if (c < cost)
+	    cost = c, last = j;
+    }
+
+    Order tour;
+    for (auto subset = full; ; ) {
+	tour.push_back(others[last]);
+	auto prev = subset ^ (uint32_t(1) << last);
+	if (prev == 0)
+	    break;
+	for (auto bits = prev; bits; bits &= bits - 1) {
+	    int k = std::countr_zero(bits);
+	    if (uint32_t(row(prev)[k]) + into[last * m + k] == row(subset)[last]) {
+		last = k;
+		break;
+	    }
+	}
+	subset = prev;
+    }
+    tour.push_back(sdx);
+    std::reverse(tour.begin(), tour.end());
+    return std::make_pair(cost, tour);
+}
+
+// Exact tour from `sdx` by dynamic programming in O(n^2 2^n) time and
+// O(n 2^n) space, returning the cost and the tour starting at `sdx` like
+// brute_force. Costs must be non-negative.
+auto held_karp(const Matrix& matrix, int sdx) {
+    const int n = matrix.nrows();
+    if (n > 30)
+	throw std::length_error("held_karp: more than 30 vertices");
+    int max_cost{};
+    for (auto i = 0; i < n; ++i)
+	for (auto j = 0; j < n; ++j) {
+	    if (matrix[i, j] < 0)
+		throw std::invalid_argument("held_karp: negative cost");
+	    max_cost = std::max(max_cost, matrix[i, j]);
+	}
+    if (int64_t(n) * max_cost < Infinity<uint16_t>)
+	return held_karp<uint16_t>(matrix, sdx);
+    if (int64_t(n) * max_cost >= Infinity<uint32_t>)
+	throw std::overflow_error("held_karp: tour costs too large");
+    return held_karp<uint32_t>(matrix, sdx);
+}
+
+// The cost of `tour` including the edge back to its start.
+int tour_cost(const Matrix& matrix, const Order& tour) {
+    int c{};
+    for (size_t i = 0; i < tour.size(); ++i)
+	c += matrix[tour[i], tour[(i + 1) % tour.size()]];
+    return c;
+}
+
+// The cost matrix of `n` random color pairs.
+Matrix random_parts(int n, std::mt19937_64& rng) {
+    std::uniform_int_distribution<int> color(0, 4);
+    ColorPairs parts;
+    for (auto i = 0; i < n; ++i)
+	parts.emplace_back(Color(color(rng)), Color(color(rng)));
+    Matrix matrix(n, n);
+    for (auto i = 0; i < n; ++i)
+	for (auto j = 0; j < n; ++j)
+	    matrix[i, j] = cost(parts[i], parts[j]);
+    return matrix;
+}
+
+// A random asymmetric matrix with costs in [1, 1000].
+Matrix random_matrix(int n, std::mt19937_64& rng) {
+    std::uniform_int_distribution<int> c(1, 1000);
+    Matrix matrix(n, n);
+    for (auto i = 0; i < n; ++i)
+	for (auto j = 0; j < n; ++j)
+	    matrix[i, j] = i == j ? 0 : c(rng);
+    return matrix;
+}
+
+// Compare held_karp with brute_force for n = 8..12, then time held_karp
+// alone up to `max_n` parts.
+void bench_exact(int max_n) {
+    std::mt19937_64 rng;
+    cout << "\nExact solvers (ms):" << endl;
+    cout << "   n  parts: brute-force   held-karp  matrix: brute-force   held-karp" << endl;
+    for (int n = 8; n <= 12; ++n) {
+	cout << std::setw(4) << n;
+	for (auto make : { random_parts, random_matrix }) {
+	    auto matrix = make(n, rng);
+	    std::pair<int, Order> bf, hk;
+	    auto bf_ns = core::timer::Timer().run(1, [&]() { bf = brute_force(matrix, 0); })
+		.elapsed_per_iteration();
+	    auto hk_ns = core::timer::Timer().run(1, [&]() { hk = held_karp(matrix, 0); })
+		.elapsed_per_iteration();
+	    bool ok = bf.first == hk.first and tour_cost(matrix, hk.second) == hk.first;
+	    cout << std::fixed << std::setprecision(3) << std::setw(20) << bf_ns / 1e6
+		 << std::setw(12) << hk_ns / 1e6 << (ok ? "" : " MISMATCH") << std::defaultfloat;
+	}
+	cout << endl;
+    }
+
+    cout << "\nHeld-Karp (ms):" << endl;
+    cout << "   n        parts       matrix" << endl;
+    for (int n = 14; n <= max_n; n += n < 20 ? 2 : 1) {
+	cout << std::setw(4) << n;
+	for (auto make : { random_parts, random_matrix }) {
+	    auto matrix = make(n, rng);
+	    std::pair<int, Order> hk;
+	    auto ns = core::timer::Timer().run(1, [&]() { hk = held_karp(matrix, 0); })
+		.elapsed_per_iteration();
+	    bool ok = tour_cost(matrix, hk.second) == hk.first and int(hk.second.size()) == n;
+	    cout << std::fixed << std::setprecision(1) << std::setw(13) << ns / 1e6
+		 << (ok ? "" : " MISMATCH") << std::defaultfloat;
+	}
+	cout << endl;
+    }
+}
+
+// Greedy tour from `sdx`: always go to the cheapest unvisited vertex.
+Order nearest_neighbor(const Matrix& matrix, int sdx) {
+    const int n = matrix.nrows();
+    std::vector<bool> visited(n);
+    Order tour{sdx};
+    visited[sdx] = true;
+    for (int i = 1; i < n; ++i) {
+	int last = tour.back(), next = -1;
+	for (int j = 0; j < n; ++j)
+	    if (not visited[j] and (next < 0 or matrix[last, j] < matrix[last, next]))
+		next = j;
+	tour.push_back(next);
+	visited[next] = true;
+    }
+    return tour;
+}
+
+// Local search.
+//
+// For thousands of parts nothing exact is feasible, so the tour from
+// nearest_neighbor is improved by two kinds of moves until neither
+// finds an improvement:
+//
+//  - 2-opt: reverse a stretch of the tour. The costs are asymmetric, so
+//    the reversed stretch's own edges change cost too; prefix sums of
+//    the tour's edges in both directions give that in O(1).
+//  - Or-opt: move a run of 1 to 3 vertices to another place.
+//  - Segment insertion: move a run of any length without reversing it
+//    (the orientation-preserving 3-opt move), which on asymmetric costs
+//    finds much of what 2-opt cannot.
+//
+// Only moves that create an edge to or from one of a vertex's k
+// cheapest neighbors are tried, and vertices whose neighborhood held no
+// improving move are skipped ("don't look") until a move touches them.
+class LocalSearch {
+public:
+    LocalSearch(const Matrix& matrix, int k)
+	: matrix_(matrix)
+	, n_(matrix.nrows())
+	, k_(std::min(k, n_ - 1))
+	, out_(size_t(n_) * k_)
+	, in_(size_t(n_) * k_) {
+	// A single vertex has no neighbors (and improve() leaves tours
+	// this short alone).
+	if (k_ == 0)
+	    return;
+	std::vector<int> others;
+	for (int v = 0; v < n_; ++v) {
+	    others.clear();
+	    for (int w = 0; w < n_; ++w)
+		if (w != v)
+		    others.push_back(w);
+	    auto nearest = [&](auto cost, int *list) {
+		std::partial_sort(others.begin(), others.begin() + k_, others.end(),
+				  [&](int a, int b) { return std::make_pair(cost(a), a) < std::make_pair(cost(b), b); });
+		std::copy_n(others.begin(), k_, list);
+	    };
+	    nearest([&](int w) { return matrix[v, w]; }, &out_[size_t(v) * k_]);
+	    nearest([&](int w) { return matrix[w, v]; }, &in_[size_t(v) * k_]);
+	}
+    }
+
+    // Improve `tour` until no candidate move helps. Then, `kicks` times,
+    // perturb the tour with a random double bridge (stretches A B C D
+    // become A C B D, nothing reversed), improve again starting from the
+    // vertices it touched, and keep the result if it is no worse. The
+    // returned tour starts at the same vertex.
+    Order improve(Order tour, int kicks = 0, uint64_t seed = 1) {
+	if (n_ < 8)
+	    kicks = 0;
+	if (n_ < 5)
+	    return tour;
+	const int start = tour[0];
+	set_order(std::move(tour));
+	queued_.assign(n_, false);
+	queue_.clear();
+	for (int v : order_)
+	    wake(v);
+	descend();
+
+	std::mt19937_64 rng(seed);
+	Order best = order_;
+	auto best_cost = forward_[n_];
+	for (int kick = 0; kick < kicks; ++kick) {
+	    // Cut points 0 < i < j < l < n in a random rotation of the tour.
+	    int shift = int(rng() % n_), cut[3];
+	    do {
+		for (auto& x : cut)
+		    x = 1 + int(rng() % (n_ - 1));
+		std::sort(cut, cut + 3);
+	    } while (cut[0] == cut[1] or cut[1] == cut[2]);
+	    scratch_.clear();
+	    for (auto [from, to] : { std::pair{0, cut[0]}, {cut[1], cut[2]}, {cut[0], cut[1]}, {cut[2], n_} })
+		for (int p = from; p < to; ++p)
+		    scratch_.push_back(at(shift + p));
+	    for (int p : { 0, cut[0] - 1, cut[0], cut[1] - 1, cut[1], cut[2] - 1, cut[2], n_ - 1 })
+		wake(at(shift + p));
+	    set_order(std::move(scratch_));
+	    descend();
+
+	    if (forward_[n_] <= best_cost) {
+		best_cost = forward_[n_];
+		best = order_;
+	    } else {
+		set_order(best);
+	    }
+	}
+
+	std::rotate(best.begin(), std::find(best.begin(), best.end(), start), best.end());
+	return best;
+    }
+
+private:
+    void set_order(Order order) {
+	order_ = std::move(order);
+	pos_.resize(n_);
+	for (int p = 0; p < n_; ++p)
+	    pos_[order_[p]] = p;
+	refresh();
+    }
+
+    // Apply improving moves around queued vertices until none is left.
+    void descend() {
+	while (not queue_.empty()) {
+	    int a = queue_.front();
+	    queue_.pop_front();
+	    queued_[a] = false;
+	    if (try_two_opt(a) or try_or_opt(a) or try_segment_insertion(a))
+		wake(a);
+	}
+    }
+
+    int at(int p) const { return order_[(p % n_ + n_) % n_]; }
+    int succ(int v) const { return at(pos_[v] + 1); }
+    int pred(int v) const { return at(pos_[v] - 1); }
+    int64_t c(int i, int j) const { return matrix_[i, j]; }
+
+    // Prefix sums of the tour's edges forward and backward: edge t runs
+    // from position t to t + 1 (the last one closes the tour).
+    void refresh() {
+	forward_.assign(n_ + 1, 0);
+	backward_.assign(n_ + 1, 0);
+	for (int t = 0; t < n_; ++t) {
+	    forward_[t + 1] = forward_[t] + c(order_[t], at(t + 1));
+	    backward_[t + 1] = backward_[t] + c(at(t + 1), order_[t]);
+	}
+    }
+
+    // Sum of edges t in [from, from + len) cyclically, in either direction.
+    static int64_t edges(const std::vector<int64_t>& sums, int from, int len, int n) {
+	int to = from + len;
+	if (to <= n)
+	    return sums[to] - sums[from];
+	return sums[n] - sums[from] + sums[to - n];
+    }
+
+    void wake(int v) {
+	if (not queued_[v]) {
+	    queued_[v] = true;
+	    queue_.push_back(v);
+	}
+    }
+
+    // Change in cost from reversing the vertices at positions i + 1 to j
+    // (cyclically): edges a -> b and e -> d become a -> e and b -> d.
+    int64_t two_opt_delta(int i, int j) const {
+	int len = ((j - i) % n_ + n_) % n_;
+	if (len < 2 or len > n_ - 2)
+	    return 0;
+	int a = at(i), b = at(i + 1), e = at(j), d = at(j + 1);
+	auto inside = edges(backward_, (i + 1) % n_, len - 1, n_) - edges(forward_, (i + 1) % n_, len - 1, n_);
+	return c(a, e) + c(b, d) - c(a, b) - c(e, d) + inside;
+    }
+
+    void reverse(int i, int j) {
+	int len = ((j - i) % n_ + n_) % n_;
+	for (int s = 0; s < len / 2; ++s) {
+	    int p = (i + 1 + s) % n_, q = ((j - s) % n_ + n_) % n_;
+	    std::swap(order_[p], order_[q]);
+	    pos_[order_[p]] = p;
+	    pos_[order_[q]] = q;
+	}
+	refresh();
+    }
+
+    // 2-opt moves that add an edge a -> w or w -> a for a candidate w.
+    bool try_two_opt(int a) {
+	for (int side = 0; side < 2; ++side)
+	    for (int t = 0; t < k_; ++t) {
+		int w = side == 0 ? out_[size_t(a) * k_ + t] : in_[size_t(a) * k_ + t];
+		int i = side == 0 ? pos_[a] : pos_[w], j = side == 0 ? pos_[w] : pos_[a];
+		if (two_opt_delta(i, j) < 0) {
+		    for (int v : { at(i), at(i + 1), at(j), at(j + 1) })
+			wake(v);
+		    reverse(i, j);
+		    return true;
+		}
+	    }
+	return false;
+    }
+
+    // Or-opt moves of the run of `len` vertices starting at a (placed
+    // after an in-neighbor w) or ending at a (placed before an
+    // out-neighbor w).
+    bool try_or_opt(int a) {
+	for (int len = 1; len <= 3; ++len)
+	    for (int side = 0; side < 2; ++side)
+		for (int t = 0; t < k_; ++t) {
+		    int first = side == 0 ? a : at(pos_[a] - len + 1);
+		    int w = side == 0 ? in_[size_t(a) * k_ + t] : out_[size_t(a) * k_ + t];
+		    int x = side == 0 ? w : pred(w);	// insert between x and succ(x)
+		    if (move_run(pos_[first], len, x))
+			return true;
+		}
+	return false;
+    }
+
+    // With b = succ(a): a -> b, c -> d and e -> f become a -> d, e -> b
+    // and c -> f for d a candidate successor of a and e a candidate
+    // predecessor of b further along, moving the run b ... c after e.
+    bool try_segment_insertion(int a) {
+	const int b = succ(a);
+	auto rel = [&](int v) { return ((pos_[v] - pos_[a]) % n_ + n_) % n_; };
+	for (int t = 0; t < k_; ++t) {
+	    int d = out_[size_t(a) * k_ + t];
+	    if (rel(d) < 2)
+		continue;
+	    int c = pred(d);
+	    auto removed = this->c(a, b) + this->c(c, d);
+	    for (int u = 0; u < k_; ++u) {
+		int e = in_[size_t(b) * k_ + u];
+		if (rel(e) < rel(d))
+		    continue;
+		int f = succ(e);
+		auto delta = this->c(a, d) + this->c(e, b) + this->c(c, f) - removed - this->c(e, f);
+		if (delta >= 0)
+		    continue;
+
+		// a, d ... e, b ... c, f ... pred(a)
+		scratch_.clear();
+		scratch_.push_back(a);
+		for (int p = pos_[d]; ; ++p) {
+		    scratch_.push_back(at(p));
+		    if (at(p) == e)
+			break;
+		}
+		for (int p = pos_[b]; ; ++p) {
+		    scratch_.push_back(at(p));
+		    if (at(p) == c)
+			break;
+		}
+		for (int p = pos_[e] + 1; at(p) != a; ++p)
+		    scratch_.push_back(at(p));
+		set_order(std::move(scratch_));
+		for (int v : { a, b, c, d, e, f })
+		    wake(v);
+		return true;
+	    }
+	}
+	return false;
+    }
+
+    // Move the run at positions [s, s + len) between x and succ(x) if
+    // that lowers the cost.
+    bool move_run(int s, int len, int x) {
+	int first = at(s), last = at(s + len - 1), p = at(s - 1), q = at(s + len);
+	int y = succ(x);
+	if (len > n_ - 3 or x == p or ((pos_[x] - s) % n_ + n_) % n_ < len)
+	    return false;
+	auto delta = c(p, q) + c(x, first) + c(last, y) - c(p, first) - c(last, q) - c(x, y);
+	if (delta >= 0)
+	    return false;
+
+	// Rebuild the order starting just after the run: q ... x, run, y ... p.
+	scratch_.clear();
+	for (int t = 0; t < n_ - len; ++t) {
+	    int v = at(s + len + t);
+	    scratch_.push_back(v);
+	    if (v == x)
+		for (int r = 0; r < len; ++r)
+		    scratch_.push_back(at(s + r));
+	}
+	set_order(std::move(scratch_));
+	for (int v : { p, q, first, last, x, y })
+	    wake(v);
+	return true;
+    }
+
+    const Matrix& matrix_;
+    const int n_, k_;
+    std::vector<int> out_, in_;		// k cheapest successors / predecessors
+    Order order_, scratch_;
+    std::vector<int> pos_;
+    std::vector<int64_t> forward_, backward_;
+    std::deque<int> queue_;
+    std::vector<bool> queued_;
+};
+
+// Heuristic tour from `sdx`: nearest neighbor, then local search over
+// `k`-nearest candidate lists with `kicks` perturbations.
+Order local_search(const Matrix& matrix, int sdx, int k = 8, int kicks = 0) {
+    return LocalSearch(matrix, k).improve(nearest_neighbor(matrix, sdx), kicks);
+}
+
+// Branch and bound.
+//
+// Partial tours from the start are extended one vertex at a time,
+// depth first, and abandoned once their lower bound reaches the best
+// tour found so far (the incumbent, initially from local_search). The
+// bound starts from the assignment problem: the cheapest way to give
+// every vertex one outgoing and one incoming edge, solved once by the
+// Hungarian method.
+// Its dual potentials u, v turn the costs into reduced costs
+// c'(i, j) = c(i, j) - u(i) - v(j) >= 0 with every tour costing
+// sum(u) + sum(v) + its reduced cost. A partial tour's bound is that
+// constant plus the reduced cost of its path plus, for the vertices
+// still needing an outgoing (incoming) edge, their cheapest reduced
+// outgoing (incoming) edge, whichever sum is larger. All of it updates
+// in O(1) per child.
+//
+// Vertices with identical costs to and from everything else (the same
+// color pair) are interchangeable in any tour, so the search only
+// visits such twins in index order; otherwise every permutation of
+// them would be searched again.
+//
+// Each thread keeps its subproblems in its own deque, working from the
+// back (depth first, cheap bound first) while idle threads steal from
+// the front, where the shallowest nodes and largest subtrees are. The
+// incumbent cost is an atomic shared by all threads.
+
+constexpr int MaxVertices = 128;
+
+struct AssignmentBound {
+    int64_t value{};
+    std::vector<int64_t> reduced;	// n x n, row major
+    std::vector<int64_t> min_out, min_in;
+};
+
+// Minimum-cost assignment of m rows to m columns (Hungarian method
+// with potentials, O(m^3)). After solve(), u[1..m] and v[1..m] are
+// dual potentials: cost(i, j) - u[i + 1] - v[j + 1] >= 0, with equality
+// on the assignment, and their sum is the minimum cost. The buffers are
+// reused from one solve to the next.
+class AssignmentSolver {
+public:
+    static constexpr int64_t Forbidden = int64_t(1) << 40;
+
+    template<class Cost>
+    int64_t solve(int m, Cost&& cost) {
+	// 1-based with row/column 0 as the sentinel.
+	u.assign(m + 1, 0);
+	v.assign(m + 1, 0);
+	match_.assign(m + 1, 0);
+	way_.assign(m + 1, 0);
+	for (int i = 1; i <= m; ++i) {
+	    match_[0] = i;
+	    int j0 = 0;
+	    minv_.assign(m + 1, std::numeric_limits<int64_t>::max());
+	    used_.assign(m + 1, false);
+	    do {
+		used_[j0] = true;
+		int i0 = match_[j0], j1{};
+		int64_t delta = std::numeric_limits<int64_t>::max();
+		for (int j = 1; j <= m; ++j) {
+		    if (used_[j])
+			continue;
+		    auto cur = cost(i0 - 1, j - 1) - u[i0] - v[j];
+		    if (cur < minv_[j])
+			minv_[j] = cur, way_[j] = j0;
+		    if (minv_[j] < delta)
+			delta = minv_[j], j1 = j;
+		}
+		for (int j = 0; j <= m; ++j) {
+		    if (used_[j])
+			u[match_[j]] += delta, v[j] -= delta;
+		    else
+			minv_[j] -= delta;
+		}
+		j0 = j1;
+	    } while (match_[j0] != 0);
+	    do {
+		int j1 = way_[j0];
+		match_[j0] = match_[j1];
+		j0 = j1;
+	    } while (j0);
+	}
+	int64_t total{};
+	for (int i = 1; i <= m; ++i)
+	    total += u[i] + v[i];
+	return total;
+    }
+
+    std::vector<int64_t> u, v;
+
+private:
+    std::vector<int> match_, way_;
+    std::vector<int64_t> minv_;
+    std::vector<char> used_;
+};
+
+// The assignment bound of the whole problem: every vertex gets one
+// outgoing and one incoming edge, never to itself.
+AssignmentBound assignment_bound(const Matrix& matrix) {
+    const int n = matrix.nrows();
+    const auto Forbidden = AssignmentSolver::Forbidden;
+    auto c = [&](int i, int j) { return i == j ? Forbidden : int64_t(matrix[i, j]); };
+    AssignmentSolver solver;
+    solver.solve(n, c);
+    auto& u = solver.u;
+    auto& v = solver.v;
+
+    AssignmentBound bound;
+    bound.reduced.resize(size_t(n) * n);
+    bound.min_out.assign(n, Forbidden);
+    bound.min_in.assign(n, Forbidden);
+    for (int i = 0; i < n; ++i) {
+	bound.value += u[i + 1] + v[i + 1];
+	for (int j = 0; j < n; ++j) {
+	    auto r = c(i, j) - u[i + 1] - v[j + 1];
+	    bound.reduced[i * n + j] = r;
+	    if (i != j) {
+		bound.min_out[i] = std::min(bound.min_out[i], r);
+		bound.min_in[j] = std::min(bound.min_in[j], r);
+	    }
+	}
+    }
+    return bound;
+}
+
+struct SearchResult {
+    int cost;
+    Order tour;
+    bool optimal;		// false if the time budget ran out
+    int64_t lower_bound;	// the assignment bound
+    size_t nodes;
+};
+
+// A partial tour: path[0, depth) from the start, its reduced cost, and
+// the sums of the cheapest reduced outgoing and incoming edges of the
+// vertices still missing one.
+struct SearchNode {
+    int64_t length, cost, need_out, need_in, bound;
+    int depth;
+    std::bitset<MaxVertices> visited;
+    uint8_t path[MaxVertices];
+};
+
+class BranchAndBound {
+public:
+    BranchAndBound(const Matrix& matrix, int sdx, int nthreads)
+	: matrix_(matrix)
+	, n_(matrix.nrows())
+	, sdx_(sdx)
+	, ap_(assignment_bound(matrix))
+	, workers_(std::max(1, nthreads))
+	, twin_(n_, -1) {
+	best_tour_ = local_search(matrix, sdx);
+	best_cost_ = tour_cost(matrix, best_tour_);
+
+	// twin_[w] is the previous vertex interchangeable with w.
+	auto same = [&](int i, int j) {
+	    if (matrix[i, j] != matrix[j, i])
+		return false;
+	    for (int k = 0; k < n_; ++k)
+		if (k != i and k != j and (matrix[i, k] != matrix[j, k] or matrix[k, i] != matrix[k, j]))
+		    return false;
+	    return true;
+	};
+	for (int w = 0; w < n_; ++w)
+	    for (int i = w - 1; i >= 0 and w != sdx; --i)
+		if (i != sdx and same(i, w)) {
+		    twin_[w] = i;
+		    break;
+		}
+    }
+
+    // Search until the incumbent is proven optimal or `budget` runs out.
+    SearchResult solve(std::chrono::milliseconds budget) {
+	deadline_ = std::chrono::steady_clock::now() + budget;
+
+	SearchNode root{};
+	root.depth = 1;
+	root.path[0] = uint8_t(sdx_);
+	root.visited.set(sdx_);
+	for (int v = 0; v < n_; ++v)
+	    root.need_out += ap_.min_out[v], root.need_in += ap_.min_in[v];
+	root.bound = ap_.value + std::max(root.need_out, root.need_in);
+	workers_[0].nodes.push_back(root);
+	outstanding_ = 1;
+
+	std::vector<std::thread> threads;
+	for (size_t i = 1; i < workers_.size(); ++i)
+	    threads.emplace_back([this, i]() { work(i); });
+	work(0);
+	for (auto& thread : threads)
+	    thread.join();
+
+	return SearchResult{ int(best_cost_.load()), best_tour_, not stop_, ap_.value, nodes_ };
+    }
+
+private:
+    struct Worker {
+	std::mutex mutex;
+	std::deque<SearchNode> nodes;
+    };
+
+    void work(size_t self) {
+	std::mt19937_64 rng(self);
+	size_t count{};
+	SearchNode node;
+	while (not stop_) {
+	    if (not pop(workers_[self], node, false)) {
+		if (outstanding_ == 0)
+		    break;
+		auto victim = rng() % workers_.size();
+		if (victim == self or not pop(workers_[victim], node, true)) {
+		    std::this_thread::yield();
+		    continue;
+		}
+	    }
+	    expand(node, workers_[self]);
+	    --outstanding_;
+	    if (++count % 64 == 0 and std::chrono::steady_clock::now() > deadline_)
+		stop_ = true;
+	}
+	std::lock_guard lock(result_mutex_);
+	nodes_ += count;
+    }
+
+    static bool pop(Worker& worker, SearchNode& node, bool steal) {
+	std::lock_guard lock(worker.mutex);
+	if (worker.nodes.empty())
+	    return false;
+	if (steal) {
+	    node = worker.nodes.front();
+	    worker.nodes.pop_front();
+	} else {
+	    node = worker.nodes.back();
+	    worker.nodes.pop_back();
+	}
+	return true;
+    }
+
+    void expand(const SearchNode& node, Worker& worker) {
+	if (node.bound >= best_cost_)
+	    return;
+	const int last = node.path[node.depth - 1];
+	if (node.depth == n_) {
+	    offer(node, node.cost + reduced(last, sdx_));
+	    return;
+	}
+	if (node.depth + 3 <= n_ and node.length + remaining_assignment(node) >= best_cost_)
+	    return;
+
+	// Children, pushed so the one with the smallest bound is on top.
+	children_.clear();
+	for (int w = 0; w < n_; ++w) {
+	    if (node.visited[w] or (twin_[w] >= 0 and not node.visited[twin_[w]]))
+		continue;
+	    auto length = node.length + matrix_[last, w];
+	    auto cost = node.cost + reduced(last, w);
+	    auto need_out = node.need_out - ap_.min_out[last];
+	    auto need_in = node.need_in - ap_.min_in[w];
+	    auto bound = ap_.value + cost + std::max(need_out, need_in);
+	    if (bound < best_cost_)
+		children_.push_back({bound, w, length, cost, need_out, need_in});
+	}
+	std::sort(children_.begin(), children_.end(), [](const auto& a, const auto& b) {
+	    return a.bound > b.bound;
+	});
+
+	outstanding_ += children_.size();
+	std::lock_guard lock(worker.mutex);
+	for (const auto& child : children_) {
+	    auto& next = worker.nodes.emplace_back(node);
+	    next.length = child.length;
+	    next.cost = child.cost;
+	    next.need_out = child.need_out;
+	    next.need_in = child.need_in;
+	    next.bound = child.bound;
+	    next.path[next.depth++] = uint8_t(child.vertex);
+	    next.visited.set(child.vertex);
+	}
+    }
+
+    // The assignment bound of completing `node`: its last vertex and the
+    // unvisited ones need an outgoing edge, the unvisited ones and the
+    // start an incoming one, and the last vertex may not go straight
+    // back to the start. Much tighter than the root's bound deep in the
+    // tree, at O(m^3) for m remaining vertices.
+    int64_t remaining_assignment(const SearchNode& node) {
+	auto& rows = rows_;
+	rows.clear();
+	rows.push_back(node.path[node.depth - 1]);
+	for (int w = 0; w < n_; ++w)
+	    if (not node.visited[w])
+		rows.push_back(w);
+	const int m = int(rows.size());
+	// Column j is rows[j + 1], and the start for j = m - 1.
+	return solver_.solve(m, [&](int i, int j) {
+	    int from = rows[i], to = j + 1 < m ? rows[j + 1] : sdx_;
+	    if (from == to or (i == 0 and j + 1 == m))
+		return AssignmentSolver::Forbidden;
+	    return int64_t(matrix_[from, to]);
+	});
+    }
+
+    // Make a complete tour of reduced cost `cost` the incumbent if it
+    // is better.
+    void offer(const SearchNode& node, int64_t cost) {
+	auto total = ap_.value + cost;
+	auto best = best_cost_.load();
+	while (total < best)
+	    if (best_cost_.compare_exchange_weak(best, total)) {
+		std::lock_guard lock(result_mutex_);
+		if (total == best_cost_)
+		    best_tour_.assign(node.path, node.path + n_);
+		break;
+	    }
+    }
+
+    int64_t reduced(int i, int j) const {
+	return ap_.reduced[i * n_ + j];
+    }
+
+    struct Child {
+	int64_t bound;
+	int vertex;
+	int64_t length, cost, need_out, need_in;
+    };
+
+    const Matrix& matrix_;
+    const int n_, sdx_;
+    AssignmentBound ap_;
+    std::vector<Worker> workers_;
+    std::vector<int> twin_;
+    static thread_local std::vector<Child> children_;
+    static thread_local std::vector<int> rows_;
+    static thread_local AssignmentSolver solver_;
+
+    std::atomic<int64_t> best_cost_;
+    std::atomic<int64_t> outstanding_{};
+    std::atomic<bool> stop_{};
+    std::chrono::steady_clock::time_point deadline_;
+    std::mutex result_mutex_;
+    Order best_tour_;
+    size_t nodes_{};
+};
+
+thread_local std::vector<BranchAndBound::Child> BranchAndBound::children_;
+thread_local std::vector<int> BranchAndBound::rows_;
+thread_local AssignmentSolver BranchAndBound::solver_;
+
+// Exact tour from `sdx` by branch and bound on `nthreads` threads, or
+// the best tour found within `budget` (optimal is then false). Costs
+// must be non-negative.
+SearchResult branch_and_bound(const Matrix& matrix, int sdx, int nthreads,
+			      std::chrono::milliseconds budget = std::chrono::hours(24)) {
+    if (matrix.nrows() > MaxVertices)
+	throw std::length_error("branch_and_bound: more than 128 vertices");
+    return BranchAndBound(matrix, sdx, nthreads).solve(budget);
+}
+
+// Check branch_and_bound against held_karp at n = 12..18, then solve
+// color-pair and random instances of 30..100 parts on `nthreads` threads
+// within `budget_ms` each.
+void bench_branch_bound(int nthreads, int budget_ms) {
+    std::mt19937_64 rng(42);
+    cout << "\nBranch and bound against Held-Karp:" << endl;
+    bool ok = true;
+    for (int n = 12; n <= 18; n += 2)
+	for (auto make : { random_parts, random_matrix }) {
+	    auto matrix = make(n, rng);
+	    auto exact = held_karp(matrix, 0);
+	    auto r = branch_and_bound(matrix, 0, nthreads);
+	    ok &= r.optimal and r.cost == exact.first and tour_cost(matrix, r.tour) == r.cost;
+	}
+    cout << "  costs match: " << std::boolalpha << ok << endl;
+
+    cout << "\nBranch and bound, " << nthreads << " thread(s), " << budget_ms << " ms budget:"
+	 << endl;
+    cout << "   n  instance   bound    cost  optimal      nodes        ms" << endl;
+    for (int n : { 30, 40, 60, 80, 100 })
+	for (auto make : { random_parts, random_matrix }) {
+	    auto matrix = make(n, rng);
+	    SearchResult r;
+	    auto ns = core::timer::Timer().run(1, [&]() {
+		r = branch_and_bound(matrix, 0, nthreads, std::chrono::milliseconds(budget_ms));
+	    }).elapsed_per_iteration();
+	    bool valid = tour_cost(matrix, r.tour) == r.cost and int(r.tour.size()) == n;
+	    cout << std::setw(4) << n << std::setw(10) << (make == random_parts ? "parts" : "matrix")
+		 << std::setw(8) << r.lower_bound << std::setw(8) << r.cost
+		 << std::setw(9) << (r.optimal ? "yes" : "no") << std::setw(11) << r.nodes
+		 << std::setw(10) << std::fixed << std::setprecision(1) << ns / 1e6
+		 << std::defaultfloat << (valid ? "" : "  INVALID") << endl;
+	}
+}
+
+// Local search against exact optima: the average excess over the
+// optimum (%) of nearest neighbor and of local search with k = 8, how
+// often local search is optimal, and its time. Then the effect of k,
+// and instances of up to `max_n` parts where only the assignment bound
+// is available for comparison.
+void bench_local(int max_n) {
+    constexpr int Instances = 5;
+    std::mt19937_64 rng(7);
+    auto excess = [](int cost, int64_t best) { return 100.0 * (cost - best) / std::max<int64_t>(best, 1); };
+
+    cout << "\nLocal search against exact tours (" << Instances << " instances each):" << endl;
+    cout << "   n  instance  nearest %  local %  optimal       ms" << endl;
+    for (int n : { 12, 16, 20, 30, 40 })
+	for (auto make : { random_parts, random_matrix }) {
+	    double nn_excess{}, ls_excess{}, ns{};
+	    int optimal{}, solved{};
+	    for (int i = 0; i < Instances; ++i) {
+		auto matrix = make(n, rng);
+		int64_t best;
+		if (n <= 20) {
+		    best = held_karp(matrix, 0).first;
+		} else {
+		    auto r = branch_and_bound(matrix, 0, 1, std::chrono::milliseconds(2000));
+		    if (not r.optimal)
+			continue;
+		    best = r.cost;
+		}
+		Order tour;
+		ns += core::timer::Timer().run(1, [&]() { tour = local_search(matrix, 0); })
+		    .elapsed_per_iteration();
+		nn_excess += excess(tour_cost(matrix, nearest_neighbor(matrix, 0)), best);
+		ls_excess += excess(tour_cost(matrix, tour), best);
+		optimal += tour_cost(matrix, tour) == best;
+		++solved;
+	    }
+	    if (solved == 0)
+		continue;
+	    cout << std::setw(4) << n << std::setw(10) << (make == random_parts ? "parts" : "matrix")
+		 << std::fixed << std::setprecision(1) << std::setw(11) << nn_excess / solved
+		 << std::setw(9) << ls_excess / solved << std::setw(6) << optimal << "/" << solved
+		 << std::setprecision(3) << std::setw(9) << ns / solved / 1e6 << std::defaultfloat << endl;
+	}
+
+    cout << "\nCandidate list length, n = 20 (excess % / ms):" << endl;
+    cout << "   k        parts             matrix" << endl;
+    std::vector<std::pair<Matrix, int>> cases;
+    for (int i = 0; i < Instances; ++i)
+	for (auto make : { random_parts, random_matrix }) {
+	    auto matrix = make(20, rng);
+	    auto best = held_karp(matrix, 0).first;
+	    cases.emplace_back(std::move(matrix), best);
+	}
+    for (int k : { 2, 4, 8, 16 }) {
+	cout << std::setw(4) << k;
+	for (int kind = 0; kind < 2; ++kind) {
+	    double sum{}, ns{};
+	    for (size_t i = kind; i < cases.size(); i += 2) {
+		const auto& [matrix, best] = cases[i];
+		Order tour;
+		ns += core::timer::Timer().run(1, [&]() { tour = local_search(matrix, 0, k); })
+		    .elapsed_per_iteration();
+		sum += excess(tour_cost(matrix, tour), best);
+	    }
+	    cout << std::fixed << std::setprecision(1) << std::setw(10) << sum / Instances << " / "
+		 << std::setprecision(3) << ns / Instances / 1e6 << std::defaultfloat;
+	}
+	cout << endl;
+    }
+
+    cout << "\nDouble-bridge kicks, n = 20 (excess % / ms):" << endl;
+    cout << "   kicks        parts             matrix" << endl;
+    for (int kicks : { 0, 10, 100, 1000 }) {
+	cout << std::setw(8) << kicks;
+	for (int kind = 0; kind < 2; ++kind) {
+	    double sum{}, ns{};
+	    for (size_t i = kind; i < cases.size(); i += 2) {
+		const auto& [matrix, best] = cases[i];
+		Order tour;
+		ns += core::timer::Timer().run(1, [&]() { tour = local_search(matrix, 0, 8, kicks); })
+		    .elapsed_per_iteration();
+		sum += excess(tour_cost(matrix, tour), best);
+	    }
+	    cout << std::fixed << std::setprecision(1) << std::setw(10) << sum / Instances << " / "
+		 << std::setprecision(3) << ns / Instances / 1e6 << std::defaultfloat;
+	}
+	cout << endl;
+    }
+
+    cout << "\nLarge instances:" << endl;
+    cout << "      n  instance   nearest     local   ap-bound         ms" << endl;
+    for (int n = 500; n <= max_n; n *= 2)
+	for (auto make : { random_parts, random_matrix }) {
+	    auto matrix = make(n, rng);
+	    Order tour;
+	    auto ns = core::timer::Timer().run(1, [&]() { tour = local_search(matrix, 0); })
+		.elapsed_per_iteration();
+	    bool valid = int(tour.size()) == n and tour[0] == 0
+		and std::set<int>(tour.begin(), tour.end()).size() == size_t(n);
+	    cout << std::setw(7) << n << std::setw(10) << (make == random_parts ? "parts" : "matrix")
+		 << std::setw(10) << tour_cost(matrix, nearest_neighbor(matrix, 0))
+		 << std::setw(10) << tour_cost(matrix, tour);
+	    if (n <= 1000)
+		cout << std::setw(11) << assignment_bound(matrix).value;
+	    else
+		cout << std::setw(11) << "-";
+	    cout << std::fixed << std::setprecision(1) << std::setw(11) << ns / 1e6
+		 << std::defaultfloat << (valid ? "" : "  INVALID") << endl;
+	}
+}
+
+// p7 [max-n]: the example, then the exact solvers on random instances
+// with Held-Karp up to `max-n` parts (default 22).
+//
+// p7 bnb [threads [budget-ms]]: branch and bound on 30..100 parts with
+// `threads` threads (default: all cores) and a time budget per instance
+// (default 2000 ms).
+//
+// p7 local [max-n]: local search against exact tours, then on up to
+// `max-n` parts (default 4000).
 int main(int argc, const char *argv[]) {
     ColorPairs parts = {
 	{ Color::Red, Color::Blue },
@@ -98,5 +1149,19 @@ int main(int argc, const char *argv[]) {
     for (auto p : p0)
 	cout << p << " -> ";
     cout << endl;
+
+    if (argc > 1 and std::string_view(argv[1]) == "bnb") {
+	int nthreads = argc > 2 ? std::stoi(argv[2]) : std::max(1u, std::thread::hardware_concurrency());
+	int budget_ms = argc > 3 ? std::stoi(argv[3]) : 2000;
+	bench_branch_bound(nthreads, budget_ms);
+	return 0;
+    }
+
+    if (argc > 1 and std::string_view(argv[1]) == "local") {
+	bench_local(argc > 2 ? std::stoi(argv[2]) : 4000);
+	return 0;
+    }
+
+    bench_exact(argc > 1 ? std::stoi(argv[1]) : 22);
     return 0;
 }
@@ -1,10 +1,23 @@
 // Copyright (C) 2022, 2023 by Mark Melton
 //
 
+#include <algorithm>
+#include <array>
 #include <iostream>
 #include <cstddef>
 #include <cstdint>
+#include <cstring>
+#include <new>
+#include <span>
 #include <tuple>
+#include <vector>
+#include "core/timer/timer.h"
+
+#ifdef __AVX2__
+#include <immintrin.h>
+#endif
+
+using std::cout, std::endl;
 
 template <typename /*CRTP*/>
 struct calc_offset;
@@ -116,7 +129,380 @@ static_assert(offsetof(packed_1, _3) == packed_1_traits::element<3>::packed_offs
 //     Ts...;
 // };
 
-using std::cout, std::endl;
+// Compile-time summary of the layout `pod_traits` computes for a list
+// of field types: natural size (including tail padding), the bytes
+// actually used by fields and the padding in between.
+template<class Fields>
+struct layout_info {
+    using traits = pod_traits<void, Fields>;
+    static constexpr size_t count = std::tuple_size_v<Fields>;
+
+    template<size_t I>
+    using field_type = std::tuple_element_t<I, Fields>;
+
+    template<size_t I>
+    static constexpr size_t offset = traits::template element<I>::offset;
+
+    static constexpr size_t alignment = []<size_t... Is>(std::index_sequence<Is...>) {
+	return std::max({size_t{1}, alignof(field_type<Is>)...});
+    }(std::make_index_sequence<count>{});
+
+    static constexpr size_t data_size = []<size_t... Is>(std::index_sequence<Is...>) {
+	return (size_t{0} + ... + sizeof(field_type<Is>));
+    }(std::make_index_sequence<count>{});
+
+    static constexpr size_t size = [] {
+	if constexpr (count == 0) return size_t{1};
+	else {
+	    constexpr auto end = offset<count - 1> + sizeof(field_type<count - 1>);
+	    return (end + alignment - 1) / alignment * alignment;
+	}
+    }();
+
+    static constexpr size_t padding = size - data_size;
+
+    // Padding inserted immediately before field I.
+    template<size_t I>
+    static constexpr size_t padding_before = [] {
+	if constexpr (I == 0) return size_t{0};
+	else return offset<I> - (offset<I - 1> + sizeof(field_type<I - 1>));
+    }();
+};
+
+static_assert(layout_info<normal_types>::size == sizeof(normal));
+static_assert(layout_info<normal_types>::padding == sizeof(normal) - 12);
+
+// The storage order that minimizes padding: fields sorted by
+// decreasing alignment (for scalars, decreasing size), ties broken by
+// the original order. `order[k]` is the original index of the field
+// stored k-th and `position[i]` is where original field i is stored.
+template<class Fields>
+struct reordered_layout {
+    static constexpr size_t count = std::tuple_size_v<Fields>;
+
+    static constexpr auto order = []<size_t... Is>(std::index_sequence<Is...>) {
+	std::array<size_t, count> idx{Is...};
+	constexpr std::array<size_t, count> align{alignof(std::tuple_element_t<Is, Fields>)...};
+	constexpr std::array<size_t, count> size{sizeof(std::tuple_element_t<Is, Fields>)...};
+	auto before = [&](size_t a, size_t b) {
+	    return align[a] > align[b] or (align[a] == align[b] and size[a] > size[b]);
+	};
+	// Insertion sort: stable and usable in a constant expression.
+	for (size_t i = 1; i < count; ++i)
+	    for (size_t j = i; j > 0 and before(idx[j], idx[j - 1]); --j)
+		std::swap(idx[j], idx[j - 1]);
+	return idx;
+    }(std::make_index_sequence<count>{});
+
+    static constexpr auto position = [] {
+	std::array<size_t, count> pos{};
+	for (size_t k = 0; k < count; ++k)
+	    pos[order[k]] = k;
+	return pos;
+    }();
+
+    using storage_types = decltype([]<size_t... Ks>(std::index_sequence<Ks...>) {
+	return std::tuple<std::tuple_element_t<order[Ks], Fields>...>{};
+    }(std::make_index_sequence<count>{}));
+
+    using info = layout_info<storage_types>;
+
+    // Offset of original field I in the reordered storage.
+    template<size_t I>
+    static constexpr size_t offset = info::template offset<position[I]>;
+};
+
+// A record whose fields are stored in the padding-minimizing order of
+// `reordered_layout` but are accessed by their original index, so code
+// written against the original declaration order is unchanged. The
+// fields live in raw bytes that are copied and discarded as such, so
+// they must be trivially copyable and destructible.
+template<class Fields>
+class reordered_record {
+public:
+    using layout = reordered_layout<Fields>;
+
+    template<size_t I>
+    using field_type = std::tuple_element_t<I, Fields>;
+
+    static_assert([]<size_t... Is>(std::index_sequence<Is...>) {
+	return ((std::is_trivially_copyable_v<field_type<Is>>
+		 and std::is_trivially_destructible_v<field_type<Is>>) and ...);
+    }(std::make_index_sequence<layout::count>{}),
+	"reordered_record: fields must be trivially copyable and destructible");
+
+    reordered_record() {
+	[&]<size_t... Is>(std::index_sequence<Is...>) {
+	    (new (data_ + layout::template offset<Is>) field_type<Is>{}, ...);
+	}(std::make_index_sequence<layout::count>{});
+    }
+
+    template<size_t I>
+    field_type<I>& get() {
+	return *std::launder(reinterpret_cast<field_type<I>*>(data_ + layout::template offset<I>));
+    }
+
+    template<size_t I>
+    const field_type<I>& get() const {
+	return *std::launder(reinterpret_cast<const field_type<I>*>(data_ + layout::template offset<I>));
+    }
+
+private:
+    alignas(layout::info::alignment) std::byte data_[layout::info::size];
+};
+
+using normal_reordered = reordered_record<normal_types>;
+static_assert(sizeof(normal_reordered) == 16);
+static_assert(normal_reordered::layout::order == std::array<size_t, 4>{1, 3, 0, 2});
+static_assert(normal_reordered::layout::offset<1> == 0);
+static_assert(normal_reordered::layout::offset<3> == 8);
+
+template<class Fields>
+void print_layout(std::ostream& os, std::string_view name) {
+    using info = layout_info<Fields>;
+    os << name << ": size " << info::size << " data " << info::data_size
+       << " padding " << info::padding << endl;
+    [&]<size_t... Is>(std::index_sequence<Is...>) {
+	((os << "  field " << Is << ": offset " << info::template offset<Is>
+	  << " size " << sizeof(typename info::template field_type<Is>)
+	  << " padding-before " << info::template padding_before<Is> << endl), ...);
+    }(std::make_index_sequence<info::count>{});
+}
+
+template<class Fields>
+void print_reordered(std::ostream& os, std::string_view name) {
+    using layout = reordered_layout<Fields>;
+    print_layout<typename layout::storage_types>(os, name);
+    os << "  order:";
+    for (auto idx : layout::order)
+	os << " " << idx;
+    os << endl;
+}
+
+// Stream over `n` records reading two fields (the natural layout
+// `normal` against the reordered one) and report time and effective
+// bandwidth over the bytes the array occupies.
+void bench_layouts(size_t n) {
+    std::vector<normal> natural(n);
+    std::vector<normal_reordered> reordered(n);
+    for (size_t i = 0; i < n; ++i) {
+	natural[i]._1 = i;
+	natural[i]._3 = i % 1000;
+	reordered[i].get<1>() = i;
+	reordered[i].get<3>() = i % 1000;
+    }
+
+    auto report = [&](std::string_view desc, size_t bytes, double ns) {
+	cout << desc << ": " << bytes / (1 << 20) << " MB " << ns / 1e6 << " ms "
+	     << bytes / ns << " GB/s" << endl;
+    };
+
+    uint64_t sum{};
+    auto ns = core::timer::Timer().run(10, [&]() {
+	for (const auto& r : natural)
+	    sum += r._1 + r._3;
+    }).elapsed_per_iteration();
+    report("natural  ", n * sizeof(normal), ns);
+
+    ns = core::timer::Timer().run(10, [&]() {
+	for (const auto& r : reordered)
+	    sum += r.get<1>() + r.get<3>();
+    }).elapsed_per_iteration();
+    report("reordered", n * sizeof(normal_reordered), ns);
+    cout << "checksum " << sum << endl;
+}
+
+#ifdef __AVX2__
+// Copy a `Size`-byte field from `n` records `stride` bytes apart,
+// starting at `src`, into the dense array `out` using AVX2 gathers
+// with byte-granular (unaligned) indices. Fields narrower than 4 bytes
+// are gathered as 32-bit words and narrowed with shuffles, so the
+// caller must ensure the 4-byte load of each record stays inside the
+// buffer. Returns the number of records copied; the remainder is left
+// to the scalar loop.
+template<size_t Size>
+size_t gather_avx2(const std::byte *src, size_t stride, size_t n, std::byte *out) {
+    size_t i = 0;
+    if constexpr (Size == 8) {
+	const int s = stride;
+	const __m128i idx = _mm_setr_epi32(0, s, 2 * s, 3 * s);
+	for (; i + 4 <= n; i += 4) {
+	    auto base = reinterpret_cast<const long long*>(src + i * stride);
+	    auto v = _mm256_i32gather_epi64(base, idx, 1);
+	    _mm256_storeu_si256(reinterpret_cast<__m256i*>(out + i * 8), v);
+	}
+    } else if constexpr (Size == 4 or Size == 2 or Size == 1) {
+	const auto idx = _mm256_mullo_epi32(_mm256_setr_epi32(0, 1, 2, 3, 4, 5, 6, 7),
+					    _mm256_set1_epi32(stride));
+	const auto narrow16 = _mm256_setr_epi8(0, 1, 4, 5, 8, 9, 12, 13, -1, -1, -1, -1, -1, -1, -1, -1,
+					       0, 1, 4, 5, 8, 9, 12, 13, -1, -1, -1, -1, -1, -1, -1, -1);
+	const auto narrow8 = _mm256_setr_epi8(0, 4, 8, 12, -1, -1, -1, -1, -1, -1, -1, -1, -1, -1, -1, -1,
+					      0, 4, 8, 12, -1, -1, -1, -1, -1, -1, -1, -1, -1, -1, -1, -1);
+	for (; i + 8 <= n; i += 8) {
+	    auto base = reinterpret_cast<const int*>(src + i * stride);
+	    auto v = _mm256_i32gather_epi32(base, idx, 1);
+	    auto dst = out + i * Size;
+	    if constexpr (Size == 4) {
+		_mm256_storeu_si256(reinterpret_cast<__m256i*>(dst), v);
+	    } else if constexpr (Size == 2) {
+		v = _mm256_permute4x64_epi64(_mm256_shuffle_epi8(v, narrow16), 0b11'01'10'00);
+		_mm_storeu_si128(reinterpret_cast<__m128i*>(dst), _mm256_castsi256_si128(v));
+	    } else {
+		v = _mm256_shuffle_epi8(v, narrow8);
+		v = _mm256_permutevar8x32_epi32(v, _mm256_setr_epi32(0, 4, 1, 1, 1, 1, 1, 1));
+		_mm_storel_epi64(reinterpret_cast<__m128i*>(dst), _mm256_castsi256_si128(v));
+	    }
+	}
+    }
+    return i;
+}
+#endif
+
+// A view of a byte buffer holding records with the given fields laid
+// out back to back without padding (as `packed_1`), using the offsets
+// from `calc_packed_offset`. Fields are read and written with memcpy
+// so no unaligned loads are performed through typed pointers, and
+// `gather<I>` copies one field of a run of records into a dense column,
+// using AVX2 gathers when available.
+template<class... Fields>
+class packed_view {
+public:
+    using types = std::tuple<Fields...>;
+    using traits = pod_traits<void, types>;
+    static constexpr size_t record_size = (size_t{0} + ... + sizeof(Fields));
+
+    template<size_t I>
+    using field_type = std::tuple_element_t<I, types>;
+
+    template<size_t I>
+    static constexpr size_t offset = traits::template element<I>::packed_offset;
+
+    packed_view(std::byte *data, size_t nrecords)
+	: data_(data)
+	, nrecords_(nrecords) {
+    }
+
+    auto size() const {
+	return nrecords_;
+    }
+
+    template<size_t I>
+    field_type<I> get(size_t idx) const {
+	field_type<I> value;
+	std::memcpy(&value, data_ + idx * record_size + offset<I>, sizeof(value));
+	return value;
+    }
+
+    template<size_t I>
+    void set(size_t idx, const field_type<I>& value) {
+	std::memcpy(data_ + idx * record_size + offset<I>, &value, sizeof(value));
+    }
+
+    // Copy field I of records [first, first + out.size()) into `out`.
+    template<size_t I>
+    void gather(std::span<field_type<I>> out, size_t first = 0) const {
+	using T = field_type<I>;
+	auto src = data_ + first * record_size + offset<I>;
+	auto dst = reinterpret_cast<std::byte*>(out.data());
+	size_t n = out.size(), i = 0;
+#ifdef __AVX2__
+	if constexpr (sizeof(T) == 1 or sizeof(T) == 2 or sizeof(T) == 4 or sizeof(T) == 8) {
+	    // Narrow fields are loaded as 4 bytes: stop where that load
+	    // would run past the last record.
+	    size_t avail = (nrecords_ - first) * record_size - offset<I>;
+	    size_t load = std::max<size_t>(sizeof(T), 4);
+	    size_t safe = avail >= load ? std::min(n, (avail - load) / record_size + 1) : 0;
+	    i = gather_avx2<sizeof(T)>(src, record_size, safe, dst);
+	}
+#endif
+	for (; i < n; ++i)
+	    std::memcpy(dst + i * sizeof(T), src + i * record_size, sizeof(T));
+    }
+
+    // Gather several fields of records [first, first + n) at once,
+    // block by block so the records are read from memory only once.
+    template<size_t... Is>
+    void gather_columns(std::span<field_type<Is>>... outs) const {
+	constexpr size_t block = 2048;
+	const size_t n = std::min({outs.size()...});
+	for (size_t first = 0; first < n; first += block) {
+	    auto count = std::min(block, n - first);
+	    (gather<Is>(outs.subspan(first, count), first), ...);
+	}
+    }
+
+private:
+    std::byte *data_;
+    size_t nrecords_;
+};
+
+using packed_1_view = packed_view<uint8_t, uint64_t, uint8_t, uint16_t>;
+static_assert(packed_1_view::record_size == sizeof(packed_1));
+static_assert(packed_1_view::offset<1> == offsetof(packed_1, _1));
+static_assert(packed_1_view::offset<3> == offsetof(packed_1, _3));
+
+// Parse `n` packed wire records into columns: through the `#pragma
+// pack` struct, with per-record `get`, one `gather` per column and
+// with `gather_columns`.
+void bench_packed(size_t n) {
+    std::vector<std::byte> wire(n * packed_1_view::record_size);
+    packed_1_view view(wire.data(), n);
+    for (size_t i = 0; i < n; ++i) {
+	view.set<0>(i, i);
+	view.set<1>(i, i * 0x9e3779b97f4a7c15ull);
+	view.set<2>(i, i >> 8);
+	view.set<3>(i, i % 65521);
+    }
+
+    std::vector<uint64_t> c1(n), check1(n);
+    std::vector<uint16_t> c3(n), check3(n);
+    const auto records = reinterpret_cast<const packed_1*>(wire.data());
+    for (size_t i = 0; i < n; ++i) {
+	check1[i] = records[i]._1;
+	check3[i] = records[i]._3;
+    }
+
+    auto report = [&](std::string_view desc, double ns) {
+	cout << desc << ": " << ns / 1e6 << " ms " << wire.size() / ns << " GB/s" << endl;
+    };
+
+    auto ns = core::timer::Timer().run(10, [&]() {
+	for (size_t i = 0; i < n; ++i) {
+	    c1[i] = records[i]._1;
+	    c3[i] = records[i]._3;
+	}
+    }).elapsed_per_iteration();
+    report("packed-struct", ns);
+
+    ns = core::timer::Timer().run(10, [&]() {
+	for (size_t i = 0; i < n; ++i) {
+	    c1[i] = view.get<1>(i);
+	    c3[i] = view.get<3>(i);
+	}
+    }).elapsed_per_iteration();
+    report("view-get     ", ns);
+    if (c1 != check1 or c3 != check3)
+	cout << "view-get: mismatch" << endl;
+
+    std::fill(c1.begin(), c1.end(), 0);
+    std::fill(c3.begin(), c3.end(), 0);
+    ns = core::timer::Timer().run(10, [&]() {
+	view.gather<1>(c1);
+	view.gather<3>(c3);
+    }).elapsed_per_iteration();
+    report("view-gather  ", ns);
+    if (c1 != check1 or c3 != check3)
+	cout << "view-gather: mismatch" << endl;
+
+    std::fill(c1.begin(), c1.end(), 0);
+    std::fill(c3.begin(), c3.end(), 0);
+    ns = core::timer::Timer().run(10, [&]() {
+	view.gather_columns<1, 3>(c1, c3);
+    }).elapsed_per_iteration();
+    report("view-columns ", ns);
+    if (c1 != check1 or c3 != check3)
+	cout << "view-columns: mismatch" << endl;
+}
 
 int main(int argc, const char *argv[]) {
 
@@ -134,5 +520,15 @@ int main(int argc, const char *argv[]) {
     cout << packed_1_traits::element<1>::packed_offset << endl;
     cout << packed_1_traits::element<2>::packed_offset << endl;
     cout << packed_1_traits::element<3>::packed_offset << endl;
+    cout << endl;
+
+    print_layout<normal_types>(cout, "normal");
+    print_reordered<normal_types>(cout, "normal (reordered)");
+    cout << endl;
+
+    size_t n = argc > 1 ? std::stoul(argv[1]) : 10'000'000;
+    bench_layouts(n);
+    cout << endl;
+    bench_packed(n);
     return 0;
 }